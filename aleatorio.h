@@ -0,0 +1,218 @@
+#ifndef ALEATORIO_H
+#define ALEATORIO_H
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+using namespace std;
+
+/**
+ * @brief Generador pseudoaleatorio xoshiro256** con semilla explícita.
+ *
+ * Reemplaza a rand()/srand(): cada instancia tiene su propio estado (no hay
+ * estado global), así que cada hilo, empresa o noticia puede usar un flujo
+ * independiente y la simulación se reproduce exactamente a partir de la semilla.
+ * Cumple los requisitos de UniformRandomBitGenerator de la biblioteca estándar.
+ */
+class GeneradorAleatorio {
+private:
+    /// Estado interno (256 bits, nunca todo en cero)
+    uint64_t estado[4];
+
+    /// @brief Rotación a la izquierda de 64 bits.
+    static uint64_t rotar(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    /**
+     * @brief Paso de splitmix64, usado para expandir una semilla de 64 bits al estado.
+     * @param x Estado de splitmix (se avanza).
+     * @return Siguiente valor de la secuencia.
+     */
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+public:
+    typedef uint64_t result_type;
+
+    /**
+     * @brief Constructor a partir de una semilla.
+     * @param semilla Semilla de 64 bits (cualquier valor es válido).
+     */
+    explicit GeneradorAleatorio(uint64_t semilla = 0) { sembrar(semilla); }
+
+    /**
+     * @brief Constructor de un flujo derivado de una semilla y un identificador.
+     *
+     * Flujos con distinto identificador (un ticker, un número de noticia) son
+     * independientes entre sí, y cada uno se reproduce igual sin importar en
+     * qué orden ni en qué hilo se genere.
+     * @param semilla Semilla global de la simulación.
+     * @param flujo Identificador del flujo.
+     */
+    GeneradorAleatorio(uint64_t semilla, uint64_t flujo) {
+        uint64_t x = semilla;
+        sembrar(splitmix64(x) ^ flujo * 0xd1342543de82ef95ULL);
+    }
+
+    /**
+     * @brief Reinicia el estado a partir de una semilla.
+     * @param semilla Semilla de 64 bits.
+     */
+    void sembrar(uint64_t semilla) {
+        uint64_t x = semilla;
+        for (int i = 0; i < 4; ++i) estado[i] = splitmix64(x);
+    }
+
+    /// @brief Menor valor que puede devolver el generador.
+    static constexpr result_type min() { return 0; }
+    /// @brief Mayor valor que puede devolver el generador.
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    /// @brief Siguiente número de 64 bits.
+    uint64_t operator()() {
+        const uint64_t resultado = rotar(estado[1] * 5, 7) * 9;
+        const uint64_t t = estado[1] << 17;
+        estado[2] ^= estado[0];
+        estado[3] ^= estado[1];
+        estado[1] ^= estado[2];
+        estado[0] ^= estado[3];
+        estado[2] ^= t;
+        estado[3] = rotar(estado[3], 45);
+        return resultado;
+    }
+
+    /**
+     * @brief Entero uniforme en [0, n) sin sesgo (método de multiplicación de Lemire).
+     * @param n Cota superior exclusiva (mayor que 0).
+     * @return Entero en [0, n).
+     */
+    uint32_t menorQue(uint32_t n) {
+        uint64_t m = (uint64_t)(uint32_t)((*this)() >> 32) * n;
+        uint32_t bajo = (uint32_t)m;
+        if (bajo < n) {
+            const uint32_t umbral = (0u - n) % n;
+            while (bajo < umbral) {
+                m = (uint64_t)(uint32_t)((*this)() >> 32) * n;
+                bajo = (uint32_t)m;
+            }
+        }
+        return (uint32_t)(m >> 32);
+    }
+
+    /**
+     * @brief Entero uniforme en [minimo, maximo].
+     * @param minimo Cota inferior (incluida).
+     * @param maximo Cota superior (incluida).
+     * @return Entero en el rango.
+     */
+    int entero(int minimo, int maximo) {
+        return minimo + (int)menorQue((uint32_t)(maximo - minimo) + 1);
+    }
+
+    /// @brief Real uniforme en [0, 1) con 53 bits de precisión.
+    double real() { return ((*this)() >> 11) * 0x1.0p-53; }
+
+    /**
+     * @brief Normal estándar N(0, 1) por el método de Box-Muller.
+     * @return Valor con distribución normal estándar.
+     */
+    double normal() {
+        double u1 = 1.0 - real();  // (0, 1]: evita log(0)
+        double u2 = real();
+        return sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+    }
+
+    /**
+     * @brief Llena un buffer con normales estándar, dos por cada par de uniformes.
+     * @param destino Buffer de salida.
+     * @param n Cantidad de números.
+     */
+    void llenarNormales(float* destino, size_t n) {
+        for (size_t i = 0; i < n; i += 2) {
+            double radio = sqrt(-2.0 * log(1.0 - real()));
+            double angulo = 6.283185307179586 * real();
+            destino[i] = (float)(radio * cos(angulo));
+            if (i + 1 < n) destino[i + 1] = (float)(radio * sin(angulo));
+        }
+    }
+
+    /**
+     * @brief Llena un buffer con números de 64 bits.
+     * @param destino Buffer de salida.
+     * @param n Cantidad de números.
+     */
+    void llenar(uint64_t* destino, size_t n) {
+        for (size_t i = 0; i < n; ++i) destino[i] = (*this)();
+    }
+
+    /**
+     * @brief Llena un buffer con enteros uniformes en [minimo, maximo].
+     * @param destino Buffer de salida.
+     * @param n Cantidad de números.
+     * @param minimo Cota inferior (incluida).
+     * @param maximo Cota superior (incluida).
+     */
+    void llenar(int* destino, size_t n, int minimo, int maximo) {
+        for (size_t i = 0; i < n; ++i) destino[i] = entero(minimo, maximo);
+    }
+
+    /**
+     * @brief Avanza el estado 2^128 pasos en tiempo constante.
+     *
+     * Equivale a 2^128 llamadas: los flujos obtenidos con saltos sucesivos no
+     * se solapan y sirven como flujos por hilo.
+     */
+    void saltar() {
+        static const uint64_t SALTO[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                          0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        uint64_t nuevo[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 4; ++i) {
+            for (int b = 0; b < 64; ++b) {
+                if (SALTO[i] & (1ULL << b)) {
+                    for (int k = 0; k < 4; ++k) nuevo[k] ^= estado[k];
+                }
+                (*this)();
+            }
+        }
+        for (int k = 0; k < 4; ++k) estado[k] = nuevo[k];
+    }
+
+    /**
+     * @brief Separa un flujo independiente: devuelve el estado actual y salta 2^128 pasos.
+     * @return Generador con el flujo separado.
+     */
+    GeneradorAleatorio dividir() {
+        GeneradorAleatorio separado = *this;
+        saltar();
+        return separado;
+    }
+};
+
+/**
+ * @brief Semilla tomada del reloj, para ejecuciones no reproducibles.
+ * @return Semilla de 64 bits.
+ */
+inline uint64_t semillaPorTiempo() {
+    return (uint64_t)chrono::high_resolution_clock::now().time_since_epoch().count();
+}
+
+/**
+ * @brief Hash FNV-1a de un texto, para derivar flujos por ticker o sector.
+ * @param texto Texto a resumir.
+ * @return Hash de 64 bits.
+ */
+inline uint64_t hashTexto(const string& texto) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : texto) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * @file arbolEmpresas.cpp
+ * @brief Profundidad y búsqueda del árbol de empresas con tickers que llegan ordenados.
+ *
+ * Para 50, 10k y 1M tickers en orden alfabético (el caso de un archivo de
+ * proveedor ya ordenado) arma un árbol con insertarEmpresa uno por uno y otro
+ * con cargarEmpresasOrdenadas, además de las 50 empresas del constructor.
+ * Comprueba que ambos encuentren todos los tickers y que la profundidad no
+ * pase la cota de un AVL (1,44 log2(n + 2)), y mide el tiempo de carga y la
+ * latencia de buscarEmpresa con tickers dispersos por todo el árbol.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread bench/arbolEmpresas.cpp -o arbolEmpresas
+ * Uso: ./arbolEmpresas
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "../empresa.h"
+using namespace std;
+
+/// @brief Milisegundos transcurridos desde `inicio`.
+static double msDesde(chrono::steady_clock::time_point inicio) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+}
+
+/// @brief Ticker sintético número i; los tickers salen en orden alfabético.
+static string ticker(size_t i) {
+    char texto[24];
+    snprintf(texto, sizeof(texto), "T%07zu", i);
+    return texto;
+}
+
+/// @brief true si el árbol encuentra todos los tickers.
+static bool encuentraTodos(ABBEmpresas& arbol, const vector<DatosEmpresa>& datos) {
+    for (const DatosEmpresa& d : datos) {
+        Empresa* e = arbol.buscarEmpresa(d.ticker);
+        if (!e || e->ticker != d.ticker) return false;
+    }
+    return true;
+}
+
+int main() {
+    printf("tickers | insertarEmpresa: profundidad, tiempo | cargarEmpresasOrdenadas: profundidad, tiempo | búsqueda\n");
+    bool correcto = true;
+    for (size_t n : {(size_t)50, (size_t)10000, (size_t)1000000}) {
+        vector<DatosEmpresa> datos(n);
+        for (size_t i = 0; i < n; ++i) datos[i] = {ticker(i), "Empresa " + to_string(i), "Tecnología", 100.0f};
+
+        ABBEmpresas uno;
+        auto inicio = chrono::steady_clock::now();
+        for (const DatosEmpresa& d : datos) uno.insertarEmpresa(d.ticker, d.nombre, d.sector, d.precio);
+        double insertar = msDesde(inicio);
+
+        ABBEmpresas masivo;
+        inicio = chrono::steady_clock::now();
+        masivo.cargarEmpresasOrdenadas(datos);
+        double cargar = msDesde(inicio);
+
+        // Cota de altura de un AVL con n + 50 nodos (las 50 del constructor)
+        double cota = 1.44 * log2((double)n + 50 + 2);
+        bool bien = encuentraTodos(uno, datos) && encuentraTodos(masivo, datos) && uno.profundidad() <= cota &&
+                    masivo.profundidad() <= cota;
+        correcto = correcto && bien;
+
+        // Búsquedas de tickers dispersos (copiados antes, para medir solo el árbol)
+        const size_t busquedas = 1000000;
+        vector<string> consultas(busquedas);
+        for (size_t k = 0; k < busquedas; ++k) consultas[k] = datos[k * 2654435761ULL % n].ticker;
+        size_t encontradas = 0;
+        inicio = chrono::steady_clock::now();
+        for (const string& t : consultas) encontradas += masivo.buscarEmpresa(t) != nullptr;
+        double buscar = msDesde(inicio);
+        correcto = correcto && encontradas == busquedas;
+
+        printf("%7zu | %15d, %9.2f ms | %23d, %9.2f ms | %6.0f ns%s\n", n, uno.profundidad(), insertar,
+               masivo.profundidad(), cargar, buscar * 1e6 / busquedas, bien ? "" : "  ERROR");
+    }
+    return correcto ? 0 : 1;
+}
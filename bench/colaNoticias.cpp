@@ -0,0 +1,170 @@
+/**
+ * @file colaNoticias.cpp
+ * @brief ColaPrioridadNoticias contra la lista enlazada ordenada que reemplazó.
+ *
+ * Verificación: inserta noticias al azar con extracciones intercaladas en la
+ * cola y en la lista original (inserción lineal detrás de las de igual
+ * impacto) y comprueba que ambas extraen lo mismo y que el recorrido en orden
+ * de prioridad coincide. Medición con 1k, 10k, 100k y 1M noticias: insertar,
+ * recorrer en orden de prioridad, leer las 10 primeras y extraer todo. La
+ * lista solo se mide hasta 10k: insertar en ella es cuadrático y, cuando deja
+ * de caber en la caché, con 40k noticias ya tarda más de 10 s.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread bench/colaNoticias.cpp -o colaNoticias
+ * Uso: ./colaNoticias [noticias de la verificación]
+ */
+#include <chrono>
+#include <cstdio>
+#include "../noticia.h"
+using namespace std;
+
+/// @brief Nodo de la lista de referencia.
+struct NodoLista {
+    int impacto;
+    string titulo;
+    Fecha fecha;
+    NodoLista* siguiente;
+};
+
+/// @brief Cola de referencia: la lista enlazada ordenada por impacto que usaba la versión anterior.
+class ColaLista {
+private:
+    NodoLista* frente = nullptr;
+
+public:
+    ColaLista() {}
+    ColaLista(const ColaLista&) = delete;
+    ColaLista& operator=(const ColaLista&) = delete;
+    ~ColaLista() {
+        while (frente) {
+            NodoLista* siguiente = frente->siguiente;
+            delete frente;
+            frente = siguiente;
+        }
+    }
+
+    bool estaVacia() const { return frente == nullptr; }
+
+    /// @brief Inserta detrás de todas las noticias de impacto mayor o igual. O(n).
+    void insertar(int impacto, const string& titulo, Fecha fecha) {
+        NodoLista* nueva = new NodoLista{impacto, titulo, fecha, nullptr};
+        if (!frente || impacto > frente->impacto) {
+            nueva->siguiente = frente;
+            frente = nueva;
+            return;
+        }
+        NodoLista* actual = frente;
+        while (actual->siguiente && actual->siguiente->impacto >= impacto) actual = actual->siguiente;
+        nueva->siguiente = actual->siguiente;
+        actual->siguiente = nueva;
+    }
+
+    /// @brief Quita la primera noticia y copia su título.
+    bool extraer(string& titulo) {
+        if (!frente) return false;
+        NodoLista* primera = frente;
+        frente = frente->siguiente;
+        titulo = primera->titulo;
+        delete primera;
+        return true;
+    }
+
+    /// @brief Títulos en orden de la lista.
+    vector<string> titulos() const {
+        vector<string> salida;
+        for (NodoLista* n = frente; n; n = n->siguiente) salida.push_back(n->titulo);
+        return salida;
+    }
+};
+
+/// @brief Milisegundos transcurridos desde `inicio`.
+static double msDesde(chrono::steady_clock::time_point inicio) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+}
+
+int main(int argc, char** argv) {
+    int verificacion = argc > 1 ? atoi(argv[1]) : 10000;
+
+    // Verificación contra la lista, con extracciones intercaladas
+    {
+        ColaPrioridadNoticias cola;
+        ColaLista lista;
+        GeneradorAleatorio azar(9, 1);
+        size_t extraidas = 0;
+        for (int i = 0; i < verificacion; ++i) {
+            int impacto = azar.entero(1, 10);
+            string titulo = "Noticia " + to_string(i);
+            Fecha fecha = generarFecha(azar.menorQue(300));
+            cola.insertar(impacto, titulo, "", SECTORES_EMPRESA[azar.menorQue(SECTORES_EMPRESA.size())], fecha);
+            lista.insertar(impacto, titulo, fecha);
+            if (azar.menorQue(3) == 0) {
+                NoticiaExtraida n;
+                string esperado;
+                if (!cola.extraer(n) || !lista.extraer(esperado) || n.titulo != esperado) {
+                    printf("ERROR: la extracción %zu difiere de la lista\n", extraidas);
+                    return 1;
+                }
+                extraidas++;
+            }
+        }
+        vector<string> esperado = lista.titulos(), recorrido;
+        for (const Noticia* n : cola) recorrido.push_back(string(n->titulo));
+        if (recorrido != esperado) {
+            printf("ERROR: el recorrido en orden de prioridad difiere de la lista\n");
+            return 1;
+        }
+        printf("verificación: %d inserciones y %zu extracciones en el mismo orden que la lista\n", verificacion,
+               extraidas);
+    }
+
+    printf("noticias | lista: insertar | lista: extraer | cola: insertar | ns/inserción | recorrer | 10 primeras | extraer | ns/extracción\n");
+    for (int cantidad : {1000, 10000, 100000, 1000000}) {
+        vector<NoticiaGenerada> lote = generarLoteNoticias(cantidad, 42, 1);
+        double listaInsertar = -1, listaExtraer = -1;
+        if (cantidad <= 10000) {
+            ColaLista lista;
+            auto inicio = chrono::steady_clock::now();
+            for (const NoticiaGenerada& n : lote) lista.insertar(n.impacto, TITULOS_NOTICIA[n.titulo], n.fecha);
+            listaInsertar = msDesde(inicio);
+            inicio = chrono::steady_clock::now();
+            string titulo;
+            while (lista.extraer(titulo)) {}
+            listaExtraer = msDesde(inicio);
+        }
+
+        ColaPrioridadNoticias cola;
+        auto inicio = chrono::steady_clock::now();
+        for (const NoticiaGenerada& n : lote)
+            cola.insertar(n.impacto, TITULOS_NOTICIA[n.titulo], DESCRIPCIONES_NOTICIA[n.descripcion],
+                          SECTORES_EMPRESA[n.sector], n.fecha, n.esPositiva);
+        double insertar = msDesde(inicio);
+
+        inicio = chrono::steady_clock::now();
+        long long suma = 0;
+        for (const Noticia* n : cola) suma += n->impacto;
+        double recorrer = msDesde(inicio);
+
+        inicio = chrono::steady_clock::now();
+        int vistas = 0;
+        for (const Noticia* n : cola) {
+            suma += n->impacto;
+            if (++vistas == 10) break;
+        }
+        double primeras = msDesde(inicio);
+
+        inicio = chrono::steady_clock::now();
+        NoticiaExtraida n;
+        while (cola.extraer(n)) suma -= n.impacto;
+        double extraer = msDesde(inicio);
+
+        char lista1[32] = "-", lista2[32] = "-";
+        if (listaInsertar >= 0) {
+            snprintf(lista1, sizeof(lista1), "%.1f ms", listaInsertar);
+            snprintf(lista2, sizeof(lista2), "%.1f ms", listaExtraer);
+        }
+        printf("%8d | %15s | %14s | %11.1f ms | %12.0f | %5.2f ms | %9.4f ms | %4.1f ms | %13.0f\n", cantidad, lista1,
+               lista2, insertar, insertar * 1e6 / cantidad, recorrer, primeras, extraer, extraer * 1e6 / cantidad);
+        if (suma < 0) printf("%lld\n", suma); // evita que los recorridos se eliminen
+    }
+    return 0;
+}
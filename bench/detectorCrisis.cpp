@@ -0,0 +1,109 @@
+/**
+ * @file detectorCrisis.cpp
+ * @brief DetectorCrisis contra un recálculo por fuerza bruta, y costo de registrar una noticia.
+ *
+ * Verificación: con ventanas al azar, registra y retira noticias (algunas con
+ * fechas atrasadas) y tras cada paso compara los contadores de cada sector y
+ * su estado de alerta con los que resultan de recorrer todas las noticias
+ * vivas. Medición: nanosegundos por noticia registrada, costo de consultar si
+ * hay alerta y, como referencia, el de recorrer todas las noticias una vez.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread bench/detectorCrisis.cpp -o detectorCrisis
+ * Uso: ./detectorCrisis [pruebas] [noticias a medir]
+ */
+#include <chrono>
+#include <cstdio>
+#include "../noticia.h"
+using namespace std;
+
+/// @brief Compara el detector con el recálculo desde cero sobre las noticias vivas.
+static bool coincide(DetectorCrisis& detector, const vector<Noticia*>& vivas, int corta, int larga, int alto) {
+    int32_t hoy = detector.fechaActual().indiceHabil();
+    UmbralCrisis umbral;  // Los de fábrica: la prueba no los cambia
+    for (const EstadoCrisisSector& e : detector.estados()) {
+        EstadoCrisisSector esperado;
+        for (const Noticia* n : vivas) {
+            if (plegarTexto(n->sectorAfectado) != plegarTexto(e.sector)) continue;
+            int32_t dia = n->fecha.indiceHabil();
+            if (dia > hoy - larga) {
+                esperado.noticiasLarga++;
+                esperado.sumaLarga += n->impacto;
+                esperado.altasLarga += n->impacto >= alto;
+            }
+            if (dia > hoy - corta) {
+                esperado.noticiasCorta++;
+                esperado.sumaCorta += n->impacto;
+                esperado.altasCorta += n->impacto >= alto;
+            }
+        }
+        esperado.enAlerta = esperado.altasCorta >= umbral.altasVentanaCorta || esperado.sumaLarga >= umbral.sumaVentanaLarga;
+        if (esperado.noticiasLarga != e.noticiasLarga || esperado.sumaLarga != e.sumaLarga ||
+            esperado.altasLarga != e.altasLarga || esperado.noticiasCorta != e.noticiasCorta ||
+            esperado.sumaCorta != e.sumaCorta || esperado.altasCorta != e.altasCorta || esperado.enAlerta != e.enAlerta)
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int pruebas = argc > 1 ? atoi(argv[1]) : 200;
+    int cantidad = argc > 2 ? atoi(argv[2]) : 1000000;
+    GeneradorAleatorio azar(7, 1);
+
+    // Verificación con ventanas, fechas y retiros al azar
+    for (int prueba = 0; prueba < pruebas; ++prueba) {
+        int corta = 1 + azar.menorQue(7), larga = corta + azar.menorQue(25);
+        DetectorCrisis detector(corta, larga, 8);
+        vector<Noticia*> vivas;
+        int32_t dia = 20000 + azar.menorQue(100);
+        for (int paso = 0; paso < 400; ++paso) {
+            if (!vivas.empty() && azar.menorQue(4) == 0) {
+                size_t k = azar.menorQue(vivas.size());
+                detector.retirar(vivas[k]);
+                delete vivas[k];
+                vivas.erase(vivas.begin() + k);
+            } else {
+                dia += azar.menorQue(3) == 0 ? azar.menorQue(4) : 0;
+                int atraso = azar.menorQue(5) == 0 ? azar.menorQue(40) : 0;
+                Noticia* n = new Noticia(azar.entero(1, 10), "t", "d", SECTORES_EMPRESA[azar.menorQue(3)],
+                                         Fecha(dia - atraso), true);
+                detector.registrar(n);
+                vivas.push_back(n);
+            }
+            if (!detector.vacio() && !coincide(detector, vivas, corta, larga, 8)) {
+                printf("ERROR en la prueba %d, paso %d (ventanas %d y %d)\n", prueba, paso, corta, larga);
+                return 1;
+            }
+        }
+        for (Noticia* n : vivas) delete n;
+    }
+    printf("verificación: %d pruebas x 400 pasos coinciden con la fuerza bruta\n", pruebas);
+
+    // Medición: 50 noticias por día, en orden cronológico
+    vector<Noticia*> noticias;
+    noticias.reserve(cantidad);
+    for (int i = 0; i < cantidad; ++i)
+        noticias.push_back(new Noticia(azar.entero(1, 10), "t", "d", SECTORES_EMPRESA[azar.menorQue(SECTORES_EMPRESA.size())],
+                                       generarFecha(i / 50), true));
+    DetectorCrisis detector;
+    vector<AlertaCrisis> alertas;
+    auto inicio = chrono::steady_clock::now();
+    for (Noticia* n : noticias) detector.registrar(n, &alertas);
+    double registrar = chrono::duration<double, nano>(chrono::steady_clock::now() - inicio).count() / cantidad;
+
+    inicio = chrono::steady_clock::now();
+    size_t enAlerta = 0;
+    for (int q = 0; q < 1000; ++q) enAlerta += detector.sectoresEnAlerta().size();
+    double consulta = chrono::duration<double, micro>(chrono::steady_clock::now() - inicio).count() / 1000;
+
+    inicio = chrono::steady_clock::now();
+    long long altas = 0;
+    for (const Noticia* n : noticias) altas += n->impacto >= 8;
+    double recorrido = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+
+    printf("%d noticias: registrar %.1f ns/noticia (%zu alertas emitidas), consultar alertas %.3f us, "
+           "recorrer todas las noticias %.2f ms (%lld de alto impacto, %zu sectores en alerta)\n",
+           cantidad, registrar, alertas.size(), consulta, recorrido, altas, enAlerta / 1000);
+    for (Noticia* n : noticias) delete n;
+    return 0;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file estudioDeEventos.cpp
+ * @brief estudioDeEventos contra un recálculo directo de cada evento, y su escalamiento con hilos.
+ *
+ * Verificación: en un mercado pequeño con precios ajustados por algunas
+ * noticias, recalcula cada par (noticia, empresa) desde cero (día 0 por
+ * búsqueda binaria, media y varianza de la ventana de estimación en dos
+ * pasadas, AR día por día) y compara cada grupo (sector, impacto, signo) con
+ * el del motor: mismos eventos y sumas iguales salvo el redondeo del orden de
+ * suma. Medición: el estudio completo del tamaño pedido con 1, 2, 4... N hilos,
+ * comprobando que el resultado sea idéntico bit a bit al de 1 hilo.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread bench/estudioDeEventos.cpp -o estudioDeEventos
+ * Uso: ./estudioDeEventos [empresas] [días] [noticias] [hilos máximos]
+ */
+#include <chrono>
+#include <cstdio>
+#include "../estudioEventos.h"
+using namespace std;
+
+/// @brief Grupo de un evento: sector, impacto y signo de la noticia.
+typedef tuple<string, int, bool> ClaveGrupo;
+
+/// @brief Estudio de referencia: cada evento se recalcula desde los cierres, sin sumas acumuladas.
+static map<ClaveGrupo, ResumenEventos> estudioDirecto(const ABBEmpresas& arbol, const ColaPrioridadNoticias& cola,
+                                                       const ConfiguracionEstudio& config) {
+    map<ClaveGrupo, ResumenEventos> grupos;
+    map<const Empresa*, pair<vector<Fecha>, vector<float>>> cierres;
+    const int L = config.longitud(), E = config.estimacion;
+    for (const Noticia* n : cola) {
+        for (const Empresa* e : arbol.obtenerEmpresasPorSector(string(n->sectorAfectado))) {
+            auto it = cierres.find(e);
+            if (it == cierres.end()) {
+                it = cierres.emplace(e, pair<vector<Fecha>, vector<float>>()).first;
+                e->historialPrecios.cierresEnOrdenDeFecha(it->second.first, it->second.second);
+            }
+            const vector<Fecha>& fechas = it->second.first;
+            const vector<float>& precios = it->second.second;
+            long long dia0 = lower_bound(fechas.begin(), fechas.end(), n->fecha) - fechas.begin();
+            long long a = dia0 + config.inicio - E, b = dia0 + config.inicio;
+            if (dia0 == (long long)fechas.size() || a < 1 || dia0 + config.fin >= (long long)fechas.size()) continue;
+            auto retorno = [&](long long j) { return (double)logf(precios[j] / precios[j - 1]); };
+            double media = 0, varianza = 0;
+            for (long long j = a; j < b; ++j) media += retorno(j);
+            media /= E;
+            for (long long j = a; j < b; ++j) varianza += (retorno(j) - media) * (retorno(j) - media);
+            varianza /= E - 1;
+            if (!(varianza > 1e-12)) continue;
+            ResumenEventos& g = grupos[ClaveGrupo(string(n->sectorAfectado), n->impacto, n->esPositiva)];
+            g.sumaAR.resize(L, 0);
+            double car = 0;
+            for (int d = 0; d < L; ++d) {
+                double ar = retorno(b + d) - media;
+                g.sumaAR[d] += ar;
+                car += ar;
+            }
+            g.eventos++;
+            g.positivos += car > 0;
+            g.sumaCAR += car;
+            g.sumaCAR2 += car * car;
+            g.sumaSCAR += car / sqrt(varianza * L);
+        }
+    }
+    return grupos;
+}
+
+/// @brief true si a y b coinciden salvo redondeo (relativo a la escala de la suma).
+static bool cerca(double a, double b, double escala) { return fabs(a - b) <= 1e-6 * max(1.0, escala); }
+
+/// @brief true si dos resúmenes son idénticos bit a bit.
+static bool identicos(const ResumenEventos& a, const ResumenEventos& b) {
+    return a.eventos == b.eventos && a.positivos == b.positivos && a.sumaCAR == b.sumaCAR && a.sumaCAR2 == b.sumaCAR2 &&
+           a.sumaSCAR == b.sumaSCAR && a.sumaAR == b.sumaAR;
+}
+
+/**
+ * @brief Agrega noticias en días del historial del mercado.
+ * @param ajustar true para que una de cada siete mueva los precios de su sector en su fecha.
+ */
+static void prepararMercado(ABBEmpresas& arbol, ColaPrioridadNoticias& cola, const ConfiguracionMercado& config,
+                            int noticias, bool ajustar) {
+    GeneradorAleatorio azar(11, 2);
+    for (int i = 0; i < noticias; ++i) {
+        Fecha fecha = config.inicio.sumarDiasHabiles(azar.menorQue(config.dias));
+        cola.insertar(azar.entero(1, 10), "t", "d", SECTORES_EMPRESA[azar.menorQue(SECTORES_EMPRESA.size())], fecha,
+                      azar.menorQue(2) == 0);
+    }
+    if (!ajustar) return;
+    size_t i = 0;
+    for (const Noticia* n : cola) {
+        if (i++ % 7 == 0) arbol.ajustarPreciosPorNoticia(string(n->sectorAfectado), n->impacto, n->fecha);
+    }
+}
+
+int main(int argc, char** argv) {
+    ConfiguracionMercado config;
+    config.empresas = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000;
+    config.dias = argc > 2 ? atoi(argv[2]) : 500;
+    int noticias = argc > 3 ? atoi(argv[3]) : 100000;
+    unsigned maximo = argc > 4 ? (unsigned)atoi(argv[4]) : hilosDisponibles();
+    config.semilla = 3;
+    config.inicio = Fecha::desdeCivil(2020, 1, 1);
+    if (maximo == 0) maximo = 1;
+    ConfiguracionEstudio estudio;
+
+    // Verificación contra el recálculo directo
+    {
+        ConfiguracionMercado pequeno = config;
+        pequeno.empresas = 400;
+        pequeno.dias = 300;
+        ABBEmpresas arbol(pequeno);
+        ColaPrioridadNoticias cola;
+        prepararMercado(arbol, cola, pequeno, 3000, true);
+        map<ClaveGrupo, ResumenEventos> esperado = estudioDirecto(arbol, cola, estudio);
+        ResultadoEstudio resultado = estudioDeEventos(arbol, cola, estudio, maximo);
+        bool igual = resultado.grupos.size() == esperado.size();
+        for (const GrupoEventos& g : resultado.grupos) {
+            auto it = esperado.find(ClaveGrupo(g.sector, g.impacto, g.esPositiva));
+            if (it == esperado.end()) {
+                igual = false;
+                break;
+            }
+            const ResumenEventos& a = g.resumen;
+            const ResumenEventos& b = it->second;
+            double escala = b.eventos;
+            igual = igual && a.eventos == b.eventos && cerca(a.sumaCAR, b.sumaCAR, escala) &&
+                    cerca(a.sumaCAR2, b.sumaCAR2, escala) && cerca(a.sumaSCAR, b.sumaSCAR, escala);
+            for (size_t d = 0; d < b.sumaAR.size() && igual; ++d) igual = cerca(a.sumaAR[d], b.sumaAR[d], escala);
+        }
+        printf("verificación: %zu eventos en %zu grupos, %s\n", resultado.eventos(), resultado.grupos.size(),
+               igual ? "iguales al recálculo directo" : "DISTINTOS del recálculo directo");
+        if (!igual) return 1;
+    }
+
+    auto inicio = chrono::steady_clock::now();
+    ABBEmpresas arbol(config);
+    ColaPrioridadNoticias cola;
+    prepararMercado(arbol, cola, config, noticias, false);
+    printf("mercado: %zu empresas x %d días y %d noticias en %.2f s\n", config.empresas, config.dias, noticias,
+           chrono::duration<double>(chrono::steady_clock::now() - inicio).count());
+
+    vector<unsigned> cantidades;
+    for (unsigned h = 1; h < maximo; h *= 2) cantidades.push_back(h);
+    cantidades.push_back(maximo);
+    printf("hilos | segundos |   eventos | M eventos/s | aceleración | resultado\n");
+    ResumenEventos base;
+    double segundosBase = 0;
+    bool iguales = true;
+    for (unsigned hilos : cantidades) {
+        ResultadoEstudio resultado = estudioDeEventos(arbol, cola, estudio, hilos);
+        ResumenEventos total = resultado.total();
+        if (hilos == 1) {
+            base = total;
+            segundosBase = resultado.segundos;
+        }
+        bool igual = identicos(total, base);
+        iguales = iguales && igual;
+        printf("%5u | %8.3f | %9zu | %11.1f | %11.2f | %s\n", hilos, resultado.segundos, total.eventos,
+               total.eventos / resultado.segundos / 1e6, segundosBase / resultado.segundos,
+               igual ? "idéntico" : "DISTINTO");
+    }
+    return iguales ? 0 : 1;
+}
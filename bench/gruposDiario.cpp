@@ -0,0 +1,48 @@
+/**
+ * @file gruposDiario.cpp
+ * @brief Rendimiento del diario según el tamaño del grupo de confirmación.
+ *
+ * Registra eventos de compra y de noticia alternados con grupos de 1, 10, 100
+ * y 1000 eventos por fdatasync e informa eventos/s y MB/s de cada caso; luego
+ * mide la lectura con verificación de CRC del diario resultante.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread bench/gruposDiario.cpp -o gruposDiario
+ * Uso: ./gruposDiario [eventos] [ruta del diario]
+ */
+#include <cstdio>
+#include "../diario.h"
+using namespace std;
+
+int main(int argc, char** argv) {
+    size_t eventos = argc > 1 ? strtoull(argv[1], nullptr, 10) : 100000;
+    string ruta = argc > 2 ? argv[2] : "grupos.dia";
+    const Fecha fecha = Fecha::desdeCivil(2025, 6, 2);
+    for (size_t grupo : {1, 10, 100, 1000}) {
+        // Con un fdatasync por evento se registran menos eventos para no alargar la medición
+        size_t n = grupo == 1 ? min<size_t>(eventos, 5000) : eventos;
+        remove(ruta.c_str());
+        Diario diario(grupo);
+        if (!diario.abrir(ruta)) return 1;
+        auto inicio = chrono::steady_clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            EventoDiario evento = (i % 2) ? EventoDiario::compra("AAPL", 3, 123.5f)
+                                          : EventoDiario::noticia(7, "Titular de prueba", "Descripción de la noticia",
+                                                                  "Tecnología", fecha);
+            diario.registrar(evento);
+        }
+        diario.confirmar();
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        printf("grupo %5zu: %7zu eventos, %7zu fdatasync, %10.0f eventos/s, %7.1f MB/s\n", grupo, n,
+               diario.confirmaciones(), n / segundos, diario.bytesEscritos() / 1e6 / segundos);
+    }
+
+    // Lectura secuencial con verificación de CRC (sin aplicar los eventos)
+    size_t leidos = 0;
+    auto inicio = chrono::steady_clock::now();
+    EstadisticasDiario est = Diario::reproducir(ruta, 0, [&](const EventoDiario&) { leidos++; });
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    printf("lectura + CRC: %zu eventos en %.3f s (%.0f eventos/s, %.0f MB/s)\n", leidos, segundos, leidos / segundos,
+           est.bytes / 1e6 / segundos);
+    remove(ruta.c_str());
+    return 0;
+}
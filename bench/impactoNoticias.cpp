@@ -0,0 +1,106 @@
+/**
+ * @file impactoNoticias.cpp
+ * @brief Tabla de impacto noticia x empresa contra el barrido completo de historiales.
+ *
+ * La referencia es el algoritmo anterior: por cada noticia y cada empresa de
+ * su sector recorre todo el historial buscando el precio de la fecha y el
+ * último anterior. Se comprueba que tablaImpactoNoticias produzca las mismas
+ * filas en el mismo orden (también filtrando por una empresa), con noticias en
+ * días hábiles, fines de semana y fechas anteriores al historial, y se miden
+ * ambos con distintos tamaños de historial y de cola.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread bench/impactoNoticias.cpp -o impactoNoticias
+ * Uso: ./impactoNoticias [empresas]
+ */
+#include <chrono>
+#include <cstdio>
+#include "../noticia.h"
+using namespace std;
+
+/// @brief Milisegundos transcurridos desde `inicio`.
+static double msDesde(chrono::steady_clock::time_point inicio) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+}
+
+/// @brief Tabla de referencia: barrido completo del historial por cada par (noticia, empresa).
+static vector<FilaImpactoNoticia> tablaPorBarrido(const ABBEmpresas& arbol, const vector<Noticia*>& noticias,
+                                                  Empresa* soloEmpresa = nullptr) {
+    vector<FilaImpactoNoticia> filas;
+    for (const Noticia* noticia : noticias) {
+        vector<Empresa*> empresas = arbol.obtenerEmpresasPorSector(string(noticia->sectorAfectado));
+        if (soloEmpresa) empresas.assign(1, soloEmpresa);
+        for (Empresa* e : empresas) {
+            if (e->sector != noticia->sectorAfectado) continue;
+            const HistorialPrecios& h = e->historialPrecios;
+            FilaImpactoNoticia fila{noticia, e, 0, 0, false};
+            bool enFecha = false;
+            Fecha anterior;
+            for (size_t i = 0; i < h.size(); ++i) {
+                if (h.fecha(i) == noticia->fecha) {
+                    enFecha = true;
+                    fila.precioDespues = h.precio(i);
+                } else if (h.fecha(i) < noticia->fecha && (!fila.hayAntes || anterior < h.fecha(i))) {
+                    fila.hayAntes = true;
+                    fila.precioAntes = h.precio(i);
+                    anterior = h.fecha(i);
+                }
+            }
+            if (enFecha) filas.push_back(fila);
+        }
+    }
+    return filas;
+}
+
+/// @brief Compara dos tablas fila por fila.
+static bool iguales(const vector<FilaImpactoNoticia>& a, const vector<FilaImpactoNoticia>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].noticia != b[i].noticia || a[i].empresa != b[i].empresa || a[i].hayAntes != b[i].hayAntes ||
+            a[i].precioDespues != b[i].precioDespues || (a[i].hayAntes && a[i].precioAntes != b[i].precioAntes))
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    size_t empresas = argc > 1 ? strtoull(argv[1], nullptr, 10) : 400;
+    printf("empresas | días | noticias |  filas | barrido     | índice    | aceleración | una empresa\n");
+    bool correcto = true;
+    for (int dias : {250, 2500}) {
+        ConfiguracionMercado config;
+        config.empresas = empresas;
+        config.dias = dias;
+        config.semilla = 3;
+        config.inicio = Fecha::desdeCivil(2015, 1, 1);
+        ABBEmpresas arbol(config);
+        vector<Empresa*> todas = arbol.obtenerEmpresasOrdenadas();
+        for (int numNoticias : {100, 1000}) {
+            ColaPrioridadNoticias cola;
+            GeneradorAleatorio azar(11, numNoticias);
+            for (int i = 0; i < numNoticias; ++i) {
+                // Casi siempre un día del historial; a veces cualquier día (fines de semana) o antes del inicio
+                Fecha fecha = config.inicio.sumarDiasHabiles(azar.menorQue(dias));
+                if (azar.menorQue(10) == 0) fecha = config.inicio + ((int)azar.menorQue(dias) - 30);
+                cola.insertar(azar.entero(1, 10), "t", "d", SECTORES_EMPRESA[azar.menorQue(SECTORES_EMPRESA.size())],
+                              fecha);
+            }
+            vector<Noticia*> noticias;
+            cola.obtenerNoticias(noticias);
+
+            auto inicio = chrono::steady_clock::now();
+            vector<FilaImpactoNoticia> esperado = tablaPorBarrido(arbol, noticias);
+            double barrido = msDesde(inicio);
+            inicio = chrono::steady_clock::now();
+            vector<FilaImpactoNoticia> filas = tablaImpactoNoticias(arbol, noticias);
+            double indice = msDesde(inicio);
+
+            Empresa* una = todas[azar.menorQue(todas.size())];
+            bool igual = iguales(filas, esperado) &&
+                         iguales(tablaImpactoNoticias(arbol, noticias, una), tablaPorBarrido(arbol, noticias, una));
+            correcto = correcto && igual;
+            printf("%8zu | %4d | %8d | %6zu | %8.1f ms | %6.2f ms | %10.0fx | %s\n", empresas, dias, numNoticias,
+                   filas.size(), barrido, indice, barrido / indice, igual ? "filas idénticas" : "FILAS DISTINTAS");
+        }
+    }
+    return correcto ? 0 : 1;
+}
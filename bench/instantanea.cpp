@@ -0,0 +1,125 @@
+/**
+ * @file instantanea.cpp
+ * @brief Tiempo de guardar y restaurar una instantánea de un mercado grande,
+ *        con verificación del estado restaurado.
+ *
+ * Genera un mercado sintético con noticias y portafolio, lo guarda con
+ * SnapshotMercado, lo restaura sobre un estado vacío y compara ambos estados
+ * (precios, historiales, indicadores, noticias y portafolio). Mide también el
+ * primer recorrido de todos los historiales restaurados, que es cuando se leen
+ * las páginas del archivo proyectado. Por último corta el archivo en varios
+ * puntos y comprueba que ninguna carga incompleta se acepte.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread bench/instantanea.cpp -o instantanea
+ * Uso: ./instantanea [empresas] [días] [ruta]
+ */
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include "../snapshot.h"
+using namespace std;
+
+/// @brief Segundos transcurridos desde `inicio`.
+static double segundosDesde(chrono::steady_clock::time_point inicio) {
+    return chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+}
+
+/// @brief Texto con todo el estado observable (empresas, historiales, indicadores, noticias y portafolio).
+static string huella(const ABBEmpresas& arbol, const ColaPrioridadNoticias& cola, const Portafolio& usuario,
+                     float presupuesto) {
+    ostringstream salida;
+    salida.precision(9);
+    salida << arbol.semilla() << " " << usuario.obtenerNombre() << " " << presupuesto << "\n";
+    for (const string& activo : usuario.obtenerActivos()) salida << "activo " << activo << "\n";
+    for (const Empresa* e : arbol.obtenerEmpresasOrdenadas()) {
+        const HistorialPrecios& h = e->historialPrecios;
+        const IndicadoresTecnicos& ind = h.indicadores();
+        salida << e->ticker << " " << e->nombre << " " << e->sector << " " << e->precioActual << " " << h.size() << " "
+               << ind.media() << " " << ind.varianza() << " " << ind.minimo() << " " << ind.maximo() << " "
+               << ind.ema() << " " << ind.rsi();
+        for (size_t i = 0; i < h.size(); ++i) salida << " " << h.fecha(i) << "=" << h.precio(i);
+        salida << "\n";
+    }
+    for (const Noticia* n : cola)
+        salida << n->impacto << " " << n->fecha << " " << n->sectorAfectado << " " << n->titulo << "\n";
+    return salida.str();
+}
+
+/// @brief Restaura la instantánea de `ruta` sobre un estado vacío; devuelve su huella o "" si se rechazó.
+static string restaurar(const string& ruta, double* segundos = nullptr, double* recorrido = nullptr) {
+    auto inicio = chrono::steady_clock::now();
+    ConfiguracionMercado vacio;
+    vacio.empresas = 0;
+    ABBEmpresas arbol(vacio);
+    ColaPrioridadNoticias cola;
+    Portafolio usuario("");
+    float presupuesto = 0;
+    if (!SnapshotMercado::cargar(ruta, arbol, cola, usuario, presupuesto)) return string();
+    if (segundos) *segundos = segundosDesde(inicio);
+    if (recorrido) {
+        inicio = chrono::steady_clock::now();
+        double suma = 0;
+        for (Empresa* e : arbol)
+            for (size_t i = 0; i < e->historialPrecios.size(); ++i) suma += e->historialPrecios.precio(i);
+        *recorrido = segundosDesde(inicio);
+        if (suma < 0) printf("%g\n", suma); // evita que el recorrido se elimine
+    }
+    return huella(arbol, cola, usuario, presupuesto);
+}
+
+int main(int argc, char** argv) {
+    ConfiguracionMercado config;
+    config.empresas = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000;
+    config.dias = argc > 2 ? atoi(argv[2]) : 2520;
+    config.semilla = 3;
+    config.inicio = Fecha::desdeCivil(2015, 1, 1);
+    string ruta = argc > 3 ? argv[3] : "instantanea.snap";
+    string rutaCortada = ruta + ".corte";
+
+    string esperado;
+    {
+        auto inicio = chrono::steady_clock::now();
+        ABBEmpresas arbol(config);
+        ColaPrioridadNoticias cola;
+        generarNoticiasAleatorias(cola, 1000, 1);
+        Portafolio usuario("Prueba");
+        vector<Empresa*> empresas = arbol.obtenerEmpresasOrdenadas();
+        for (size_t i = 0; i < empresas.size() && i < 10; ++i) usuario.agregarActivo(empresas[i]->ticker, false);
+        printf("mercado: %zu empresas x %d días generados en %.2f s\n", config.empresas, config.dias,
+               segundosDesde(inicio));
+        esperado = huella(arbol, cola, usuario, 12345.5f);
+        inicio = chrono::steady_clock::now();
+        if (!SnapshotMercado::guardar(ruta, arbol, cola, usuario, 12345.5f)) return 1;
+        printf("guardar: %.3f s\n", segundosDesde(inicio));
+    }
+
+    double segundos = 0, recorrido = 0;
+    bool iguales = restaurar(ruta, &segundos, &recorrido) == esperado;
+    printf("cargar: %.3f s; primer recorrido de los historiales: %.3f s: %s\n", segundos, recorrido,
+           iguales ? "estado idéntico" : "ESTADO DISTINTO");
+
+    // Archivos cortados: ninguno debe aceptarse
+    FILE* archivo = fopen(ruta.c_str(), "rb");
+    if (!archivo) return 1;
+    fseek(archivo, 0, SEEK_END);
+    long tamano = ftell(archivo);
+    vector<char> contenido(tamano);
+    fseek(archivo, 0, SEEK_SET);
+    size_t leidos = fread(contenido.data(), 1, tamano, archivo);
+    fclose(archivo);
+    if (leidos != (size_t)tamano) return 1;
+    size_t aceptados = 0, cortes = 0;
+    for (long corte : {tamano - 1, tamano - 5, tamano - 64, tamano / 2, (long)sizeof(SnapshotMercado::Cabecera)}) {
+        FILE* cortado = fopen(rutaCortada.c_str(), "wb");
+        if (!cortado) return 1;
+        fwrite(contenido.data(), 1, corte, cortado);
+        fclose(cortado);
+        if (!restaurar(rutaCortada).empty()) aceptados++;
+        cortes++;
+    }
+    printf("archivos cortados: %zu de %zu rechazados\n", cortes - aceptados, cortes);
+
+    remove(ruta.c_str());
+    remove(rutaCortada.c_str());
+    return iguales && aceptados == 0 ? 0 : 1;
+}
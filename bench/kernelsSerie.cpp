@@ -0,0 +1,103 @@
+/**
+ * @file kernelsSerie.cpp
+ * @brief Tiempo de cada kernel de series (escalar, SSE2, AVX2) y comparación
+ *        de sus resultados con la versión escalar.
+ *
+ * Mide suma, varianza, mínimo/máximo, producto punto y cocientes sobre una
+ * serie aleatoria (promedio de varias repeticiones) con cada implementación
+ * que la CPU soporta, y comprueba que coinciden con la escalar: mínimo y
+ * máximo exactos, sumas dentro del redondeo de double.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread bench/kernelsSerie.cpp -o kernelsSerie
+ * Uso: ./kernelsSerie [valores] [repeticiones]
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include "../empresa.h"
+using namespace std;
+
+static volatile double sumidero;
+
+/// @brief Microsegundos promedio de `repeticiones` llamadas a f.
+template <typename F>
+static double microsegundos(F f, int repeticiones) {
+    auto inicio = chrono::steady_clock::now();
+    for (int r = 0; r < repeticiones; ++r) f();
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - inicio).count() / repeticiones;
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1 << 20;
+    int repeticiones = argc > 2 ? atoi(argv[2]) : 50;
+    vector<float> a(n), b(n), cocientes(n), referencia(n);
+    mt19937 azar(1);
+    uniform_real_distribution<float> precio(10, 500);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = precio(azar);
+        b[i] = precio(azar);
+    }
+
+    vector<const KernelsSerie*> implementaciones = {&kernelsEscalares()};
+#ifdef ESTADISTICA_X86
+    static const KernelsSerie sse2 = {"sse2", sumaSSE2, sumaCuadradosDesviacionSSE2, minMaxSSE2, productoPuntoSSE2,
+                                      cocientesSSE2};
+    static const KernelsSerie avx2 = {"avx2", sumaAVX2, sumaCuadradosDesviacionAVX2, minMaxAVX2, productoPuntoAVX2,
+                                      cocientesAVX2};
+    implementaciones.push_back(&sse2);
+    if (__builtin_cpu_supports("avx2")) implementaciones.push_back(&avx2);
+#endif
+
+    const KernelsSerie& escalar = kernelsEscalares();
+    double media = escalar.suma(a.data(), n) / n;
+    double sumaRef = escalar.suma(a.data(), n);
+    double varianzaRef = escalar.sumaCuadradosDesviacion(a.data(), n, media);
+    double puntoRef = escalar.productoPunto(a.data(), b.data(), n);
+    float minimoRef, maximoRef;
+    escalar.minMax(a.data(), n, minimoRef, maximoRef);
+    escalar.cocientes(a.data(), n, referencia.data());
+
+    bool correcto = true;
+    printf("%-8s %10s %10s %10s %10s %10s  (%zu valores, kernel elegido: %s)\n", "impl", "suma", "varianza",
+           "min/max", "punto", "cocientes", n, kernelsSerie().nombre);
+    for (const KernelsSerie* k : implementaciones) {
+        double ts = microsegundos([&] { sumidero = k->suma(a.data(), n); }, repeticiones);
+        double tv = microsegundos([&] { sumidero = k->sumaCuadradosDesviacion(a.data(), n, media); }, repeticiones);
+        double tm = microsegundos([&] {
+            float minimo, maximo;
+            k->minMax(a.data(), n, minimo, maximo);
+            sumidero = minimo + maximo;
+        }, repeticiones);
+        double tp = microsegundos([&] { sumidero = k->productoPunto(a.data(), b.data(), n); }, repeticiones);
+        double tc = microsegundos([&] { k->cocientes(a.data(), n, cocientes.data()); }, repeticiones);
+        printf("%-8s %8.0f us %8.0f us %8.0f us %8.0f us %8.0f us\n", k->nombre, ts, tv, tm, tp, tc);
+
+        float minimo, maximo;
+        k->minMax(a.data(), n, minimo, maximo);
+        bool iguales = minimo == minimoRef && maximo == maximoRef &&
+                       fabs(k->suma(a.data(), n) - sumaRef) <= 1e-12 * fabs(sumaRef) + 1e-6 &&
+                       fabs(k->sumaCuadradosDesviacion(a.data(), n, media) - varianzaRef) <= 1e-9 * varianzaRef &&
+                       fabs(k->productoPunto(a.data(), b.data(), n) - puntoRef) <= 1e-12 * fabs(puntoRef) + 1e-6;
+        for (size_t i = 0; i + 1 < n && iguales; ++i)
+            iguales = fabs(cocientes[i] - referencia[i]) <= 1e-6f * referencia[i];
+        if (!iguales) {
+            printf("  %s no coincide con la versión escalar\n", k->nombre);
+            correcto = false;
+        }
+    }
+
+    // Los kernels dentro del historial: tramos por bloque y retornos logarítmicos
+    HistorialPrecios historial;
+    size_t registros = min<size_t>(n, 5000);
+    for (size_t i = 0; i < registros; ++i) historial.agregarPrecio(Fecha((int32_t)i), a[i]);
+    float minimo, maximo;
+    historial.minMaxRango(100, registros - 100, minimo, maximo);
+    minMaxEscalar(a.data() + 100, registros - 199, minimoRef, maximoRef);
+    vector<float> retornos = historial.retornosLogaritmicos();
+    bool historialCorrecto = minimo == minimoRef && maximo == maximoRef && retornos.size() == registros - 1;
+    for (size_t i = 0; i + 1 < registros && historialCorrecto; ++i)
+        historialCorrecto = fabs(retornos[i] - logf(a[i + 1] / a[i])) < 1e-6f;
+    printf("historial: %s\n", historialCorrecto ? "mínimo, máximo y retornos correctos" : "ERROR");
+    return correcto && historialCorrecto ? 0 : 1;
+}
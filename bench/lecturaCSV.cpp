@@ -0,0 +1,137 @@
+/**
+ * @file lecturaCSV.cpp
+ * @brief Rendimiento de la carga de precios desde CSV: solo la lectura y la
+ *        carga completa en el árbol y los historiales.
+ *
+ * Primero carga unos archivos pequeños con los formatos aceptados y casos
+ * límite (CRLF, líneas vacías, filas inválidas, filas desordenadas, fechas
+ * repetidas, archivo sin ticker) y compara los historiales con los
+ * esperados. Luego genera archivos OHLCV con encabezado (varios tickers por
+ * archivo, cierres con movimiento browniano geométrico), mide leerCSVPrecios
+ * sola y cargarCSV completa, y comprueba que se cargaron todas las filas.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread bench/lecturaCSV.cpp -o lecturaCSV
+ * Uso: ./lecturaCSV [archivos] [tickers por archivo] [días] [carpeta]
+ */
+#include <cmath>
+#include <cstdio>
+#include "../cargaCSV.h"
+using namespace std;
+
+/// @brief Escribe un archivo de texto.
+static bool escribir(const string& ruta, const string& contenido) {
+    FILE* salida = fopen(ruta.c_str(), "wb");
+    if (!salida) return false;
+    fwrite(contenido.data(), 1, contenido.size(), salida);
+    fclose(salida);
+    return true;
+}
+
+/// @brief Historial de un ticker como texto "fecha=precio ..." (vacío si no existe).
+static string historialComoTexto(ABBEmpresas& arbol, const string& ticker) {
+    Empresa* e = arbol.buscarEmpresa(ticker);
+    if (!e) return "";
+    string texto;
+    for (size_t i = 0; i < e->historialPrecios.size(); ++i) {
+        char registro[48];
+        snprintf(registro, sizeof(registro), "%s%s=%g", i ? " " : "", e->historialPrecios.fecha(i).aTexto().c_str(),
+                 e->historialPrecios.precio(i));
+        texto += registro;
+    }
+    return texto;
+}
+
+/// @brief Carga archivos con todos los formatos y casos límite y compara el resultado.
+static bool verificarFormatos(const string& carpeta) {
+    vector<string> rutas = {carpeta + "/mixto.csv", carpeta + "/ohlcv.csv", carpeta + "/ibm.us.csv"};
+    bool escritos = escribir(rutas[0],
+                             "Fecha,Cierre,Ticker,Sector\r\n"
+                             "2024-01-03,11,AAA,Energía\r\n"
+                             "\n"
+                             "2024-01-02,10,AAA,Energía\n"
+                             "2024-13-01,99,AAA,Energía\n"
+                             "2024-01-04,abc,AAA,Energía\n"
+                             "2024-01-04,12,BBB,Finanzas\n") &&
+                    escribir(rutas[1],
+                             "AAA,2024-01-03,1,1,1,13,100\n"
+                             "BBB,2024-01-05,1,1,1,14,100\n") &&
+                    escribir(rutas[2], "2024-01-02,20\n2024-01-03,21\n");
+    if (!escritos) return false;
+    ConfiguracionMercado vacio;
+    vacio.empresas = 0;
+    ABBEmpresas arbol(vacio);
+    EstadisticasCargaCSV carga = cargarCSV(arbol, rutas, 2);
+    for (const string& ruta : rutas) remove(ruta.c_str());
+    // La fila repetida de AAA en ohlcv.csv reemplaza a la de mixto.csv
+    bool correcto = carga.filas == 7 && carga.filasInvalidas == 2 && carga.filasRepetidas == 1 &&
+                    historialComoTexto(arbol, "AAA") == "2024-01-02=10 2024-01-03=13" &&
+                    historialComoTexto(arbol, "BBB") == "2024-01-04=12 2024-01-05=14" &&
+                    historialComoTexto(arbol, "IBM") == "2024-01-02=20 2024-01-03=21" &&
+                    arbol.buscarEmpresa("AAA")->sector == "Energía";
+    printf("formatos: %zu filas, %zu inválidas, %zu repetidas: %s\n", carga.filas, carga.filasInvalidas,
+           carga.filasRepetidas, correcto ? "historiales correctos" : "ERROR");
+    return correcto;
+}
+
+int main(int argc, char** argv) {
+    int archivos = argc > 1 ? atoi(argv[1]) : 4;
+    int tickers = argc > 2 ? atoi(argv[2]) : 500;
+    int dias = argc > 3 ? atoi(argv[3]) : 2520;
+    string carpeta = argc > 4 ? argv[4] : ".";
+    if (!verificarFormatos(carpeta)) return 1;
+
+    // Archivos de prueba
+    vector<string> rutas;
+    GeneradorAleatorio azar(3);
+    for (int f = 0; f < archivos; ++f) {
+        rutas.push_back(carpeta + "/precios" + to_string(f) + ".csv");
+        FILE* salida = fopen(rutas.back().c_str(), "w");
+        if (!salida) {
+            printf("No se pudo crear %s\n", rutas.back().c_str());
+            return 1;
+        }
+        fputs("ticker,date,open,high,low,close,volume\n", salida);
+        for (int t = 0; t < tickers; ++t) {
+            char ticker[32];
+            snprintf(ticker, sizeof(ticker), "T%02d%05d", f, t);
+            double precio = 50 + azar.real() * 400;
+            Fecha fecha = Fecha::desdeCivil(2000, 1, 3);
+            for (int d = 0; d < dias; ++d) {
+                precio *= exp(0.0002 + 0.02 * azar.normal());
+                fprintf(salida, "%s,%s,%.2f,%.2f,%.2f,%.2f,%d\n", ticker, fecha.aTexto().c_str(), precio * 0.99,
+                        precio * 1.01, precio * 0.98, precio, (int)(azar.real() * 1e6));
+                fecha = fecha.sumarDiasHabiles(1);
+            }
+        }
+        fclose(salida);
+    }
+
+    // Solo la lectura, en un hilo
+    size_t filas = 0, invalidas = 0, bytes = 0;
+    auto inicio = chrono::steady_clock::now();
+    for (const string& ruta : rutas) {
+        ArchivoMapeado archivo(ruta);
+        bytes += archivo.tamano();
+        vector<SeriePrecios> series;
+        leerCSVPrecios(archivo.inicio(), archivo.tamano(), "", series, filas, invalidas);
+    }
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    printf("lectura: %.1f MB, %zu filas en %.2f s: %.0f MB/s, %.2f M filas/s\n", bytes / 1e6, filas, segundos,
+           bytes / 1e6 / segundos, filas / 1e6 / segundos);
+
+    // Carga completa: lectura en paralelo, alta de tickers e historiales
+    ConfiguracionMercado vacio;
+    vacio.empresas = 0;
+    ABBEmpresas arbol(vacio);
+    EstadisticasCargaCSV carga = cargarCSV(arbol, rutas);
+    printf("carga completa: %zu filas, %zu tickers en %.2f s: %.0f MB/s, %.2f M filas/s\n", carga.filas,
+           carga.series, carga.segundos, carga.mbPorSegundo(), carga.filasPorSegundo() / 1e6);
+
+    size_t esperadas = (size_t)archivos * tickers * dias;
+    bool correcto = carga.filas == esperadas && carga.filasInvalidas == 0 && carga.filasRepetidas == 0 &&
+                    carga.series == (size_t)archivos * tickers &&
+                    arbol.obtenerEmpresasOrdenadas().size() == carga.series;
+    printf("%s\n", correcto ? "filas y tickers completos" : "ERROR: faltan filas o tickers");
+    for (const string& ruta : rutas) remove(ruta.c_str());
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file memoriaNoticias.cpp
+ * @brief Memoria por noticia de ColaPrioridadNoticias, con todos sus índices.
+ *
+ * Mide con mallinfo2 (glibc) los bytes reservados por una cola con 10k, 100k
+ * y 1M noticias generadas (textos de un catálogo fijo, como los de
+ * generarNoticiasAleatorias) y con títulos todos distintos. Separa la parte
+ * fija de cada noticia (el registro Noticia, su clave en el índice por fecha
+ * y sus punteros en el grupo de prioridad y en el índice invertido) del
+ * resto: listas del índice invertido, ventanas del detector de crisis,
+ * textos y la holgura de los contenedores.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread bench/memoriaNoticias.cpp -o memoriaNoticias
+ * Uso: ./memoriaNoticias
+ */
+#include <malloc.h>
+#include <cstdio>
+#include "../noticia.h"
+using namespace std;
+
+/// @brief Bytes reservados con malloc en este momento.
+static size_t bytesReservados() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+int main() {
+    const size_t fijos = sizeof(Noticia) + sizeof(ClaveFecha) + 2 * sizeof(Noticia*);
+    printf("parte fija por noticia: %zu B (Noticia %zu, clave por fecha %zu, dos punteros %zu)\n", fijos,
+           sizeof(Noticia), sizeof(ClaveFecha), 2 * sizeof(Noticia*));
+    printf("noticias | B/noticia | fija | índices, textos y holgura | textos\n");
+    for (bool distintos : {false, true}) {
+        for (int cantidad : {10000, 100000, 1000000}) {
+            vector<NoticiaGenerada> lote = generarLoteNoticias(cantidad, 42, 1);
+            size_t antes = bytesReservados();
+            {
+                ColaPrioridadNoticias cola;
+                for (size_t i = 0; i < lote.size(); ++i) {
+                    const NoticiaGenerada& n = lote[i];
+                    string titulo = TITULOS_NOTICIA[n.titulo];
+                    if (distintos) titulo += " " + to_string(i);
+                    cola.insertar(n.impacto, titulo, DESCRIPCIONES_NOTICIA[n.descripcion], SECTORES_EMPRESA[n.sector],
+                                  n.fecha, n.esPositiva);
+                }
+                double porNoticia = double(bytesReservados() - antes) / cantidad;
+                printf("%8d | %9.1f | %4zu | %25.1f | %s\n", cantidad, porNoticia, fijos, porNoticia - fijos,
+                       distintos ? "títulos únicos" : "catálogo");
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file poolNodos.cpp
+ * @brief Reservas de memoria, memoria residente y tiempos de construcción y
+ *        destrucción de un mercado grande con los pools de nodos.
+ *
+ * Cuenta cada llamada a operator new mientras se insertan N empresas y D
+ * precios por empresa (precio constante, para que los índices por precio no
+ * se reordenen) y mide la memoria residente (Linux) y el tiempo de destruir
+ * el árbol, que libera los pools en bloque.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread bench/poolNodos.cpp -o poolNodos
+ * Uso: ./poolNodos [empresas] [precios por empresa]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include "../empresa.h"
+using namespace std;
+
+static size_t reservas = 0;
+
+// operator new y delete se reemplazan en pareja sobre malloc/free
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t n) {
+    reservas++;
+    void* p = malloc(n);
+    if (!p) throw bad_alloc();
+    return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+/// @brief Memoria residente del proceso en KiB (0 si no se puede leer /proc).
+static long memoriaResidente() {
+    ifstream estado("/proc/self/status");
+    string linea;
+    while (getline(estado, linea))
+        if (linea.rfind("VmRSS:", 0) == 0) return atol(linea.c_str() + 6);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    size_t empresas = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000;
+    int dias = argc > 2 ? atoi(argv[2]) : 500;
+    vector<string> tickers;
+    char ticker[32];
+    for (size_t i = 0; i < empresas; ++i) {
+        snprintf(ticker, sizeof(ticker), "Z%06zu", i);
+        tickers.push_back(ticker);
+    }
+    ConfiguracionMercado vacio;
+    vacio.empresas = 0;
+    const Fecha inicio = Fecha::desdeCivil(2020, 1, 1);
+
+    long memoriaInicial = memoriaResidente();
+    size_t reservasIniciales = reservas;
+    auto t0 = chrono::steady_clock::now();
+    ABBEmpresas* arbol = new ABBEmpresas(vacio);
+    for (const string& t : tickers) arbol->insertarEmpresa(t, "Empresa", "Finanzas", 100);
+    for (const string& t : tickers)
+        for (int d = 0; d < dias; ++d) arbol->agregarPrecio(t, inicio + d, 100);
+    auto t1 = chrono::steady_clock::now();
+    size_t reservasConstruccion = reservas - reservasIniciales;
+    long memoria = memoriaResidente() - memoriaInicial;
+    pair<size_t, size_t> nodos = arbol->nodosReservados();
+    delete arbol;
+    auto t2 = chrono::steady_clock::now();
+
+    printf("%zu empresas x %d precios: %zu reservas de memoria, %ld MB residentes, %zu nodos de empresa y %zu "
+           "bloques de historial en los pools\n",
+           empresas, dias, reservasConstruccion, memoria / 1024, nodos.first, nodos.second);
+    printf("construcción %.0f ms, destrucción %.0f ms\n", chrono::duration<double, milli>(t1 - t0).count(),
+           chrono::duration<double, milli>(t2 - t1).count());
+    return 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file reproduccionDiario.cpp
+ * @brief Ida y vuelta del diario: una sesión en vivo contra su reproducción.
+ *
+ * Ejecuta una sesión con compras, ventas, lotes de noticias y cambios de
+ * umbrales de crisis registrándola en un diario (con puntos de control
+ * intermedios), luego restaura la instantánea del último punto de control
+ * sobre un estado vacío, reproduce el diario y
+ * compara ambos estados byte a byte. Por último corta el diario a mitad del
+ * último registro y comprueba que la reproducción descarta solo ese evento.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread bench/reproduccionDiario.cpp -o reproduccionDiario
+ * Uso: ./reproduccionDiario [operaciones] [semilla] [ruta del diario]
+ */
+#include <cstdio>
+#include <sstream>
+#include "../diario.h"
+using namespace std;
+
+/// @brief Texto con todo el estado observable de la sesión (precios, historiales, noticias, umbrales y portafolio).
+static string huella(const ABBEmpresas& arbol, const ColaPrioridadNoticias& cola, const Portafolio& usuario,
+                     float presupuesto) {
+    ostringstream salida;
+    salida.precision(9);
+    salida << "presupuesto " << presupuesto << "\n";
+    for (const string& activo : usuario.obtenerActivos()) salida << "activo " << activo << "\n";
+    for (const Empresa* e : arbol.obtenerEmpresasOrdenadas()) {
+        const HistorialPrecios& h = e->historialPrecios;
+        salida << e->ticker << " " << e->precioActual << " " << h.size();
+        for (size_t i = 0; i < h.size(); ++i) salida << " " << h.fecha(i) << "=" << h.precio(i);
+        salida << "\n";
+    }
+    vector<Noticia*> noticias;
+    cola.obtenerNoticias(noticias);
+    for (const Noticia* n : noticias)
+        salida << n->impacto << " " << n->fecha << " " << n->sectorAfectado << " " << n->titulo << "\n";
+    for (const string& sector : SECTORES_EMPRESA) {
+        UmbralCrisis umbral = cola.detectorCrisis().umbral(sector);
+        salida << sector << " " << umbral.altasVentanaCorta << "/" << umbral.sumaVentanaLarga << "\n";
+    }
+    return salida.str();
+}
+
+int main(int argc, char** argv) {
+    size_t operaciones = argc > 1 ? strtoull(argv[1], nullptr, 10) : 5000;
+    uint64_t semilla = argc > 2 ? strtoull(argv[2], nullptr, 10) : 7;
+    string ruta = argc > 3 ? argv[3] : "reproduccion.dia";
+    string rutaControl = ruta + ".snap";
+    remove(ruta.c_str());
+    remove(rutaControl.c_str());
+
+    // Sesión en vivo, igual que el menú: cada operación se registra y se aplica
+    string esperado;
+    size_t registrados = 0;
+    {
+        ABBEmpresas arbol(semilla);
+        ColaPrioridadNoticias cola;
+        Portafolio usuario("Prueba");
+        float presupuesto = 1e7f;
+        EstadoSesion estado{arbol, cola, usuario, presupuesto};
+        Diario diario;
+        if (!diario.abrir(ruta) || !puntoDeControl(diario, rutaControl, estado)) return 1;
+        vector<Empresa*> empresas = arbol.obtenerEmpresasOrdenadas();
+        GeneradorAleatorio azar(semilla, hashTexto("reproduccion"));
+        for (size_t i = 0; i < operaciones; ++i) {
+            Empresa* e = empresas[azar.menorQue(empresas.size())];
+            uint64_t tipo = azar.menorQue(20);
+            EventoDiario evento;
+            if (tipo == 19) {
+                // Umbral de un sector o, a veces, el general
+                UmbralCrisis umbral;
+                umbral.altasVentanaCorta = azar.menorQue(6);
+                umbral.sumaVentanaLarga = 20 + azar.menorQue(60);
+                bool general = azar.menorQue(4) == 0;
+                evento = EventoDiario::umbralCrisis(general ? "" : SECTORES_EMPRESA[azar.menorQue(SECTORES_EMPRESA.size())],
+                                                    umbral);
+            } else if (tipo < 8) {
+                evento = EventoDiario::compra(e->ticker, 1 + azar.menorQue(5), e->precioActual);
+            } else if (tipo < 12) {
+                if (!usuario.tieneActivo(e->ticker)) continue;
+                evento = EventoDiario::venta(e->ticker, 1, e->precioActual);
+            } else {
+                // Un lote de noticias se aplica en una pasada y se confirma en un solo grupo
+                vector<AjusteNoticia> lote;
+                for (const NoticiaGenerada& n : generarLoteNoticias(1 + azar.menorQue(20), azar())) {
+                    EventoDiario noticia = EventoDiario::noticia(n.impacto, TITULOS_NOTICIA[n.titulo],
+                                                                 DESCRIPCIONES_NOTICIA[n.descripcion],
+                                                                 SECTORES_EMPRESA[n.sector], n.fecha);
+                    diario.registrar(noticia);
+                    aplicarEvento(noticia, estado, &lote);
+                    registrados++;
+                }
+                arbol.ajustarPreciosPorNoticias(lote, hilosDisponibles());
+                diario.confirmar();
+                continue;
+            }
+            diario.registrar(evento);
+            aplicarEvento(evento, estado);
+            registrados++;
+            diario.confirmar();
+            if (diario.eventosSinControl() >= 5000) puntoDeControl(diario, rutaControl, estado);
+        }
+        esperado = huella(arbol, cola, usuario, presupuesto);
+        printf("sesión: %zu eventos, %zu confirmaciones, %zu bytes\n", registrados, diario.confirmaciones(),
+               diario.bytesEscritos());
+    }
+
+    // Reproducción sobre la instantánea del último punto de control
+    auto reproducir = [&](EstadisticasDiario& est) {
+        ConfiguracionMercado vacio;
+        vacio.empresas = 0;
+        ABBEmpresas arbol(vacio);
+        ColaPrioridadNoticias cola;
+        Portafolio usuario("");
+        float presupuesto = 0;
+        uint64_t secuencia = 0;
+        if (!SnapshotMercado::cargar(rutaControl, arbol, cola, usuario, presupuesto, &secuencia)) return string();
+        EstadoSesion estado{arbol, cola, usuario, presupuesto};
+        est = reproducirDiario(ruta, secuencia, estado);
+        return huella(arbol, cola, usuario, presupuesto);
+    };
+    EstadisticasDiario est;
+    bool iguales = reproducir(est) == esperado;
+    printf("reproducción: %zu eventos (%zu ya en la instantánea) en %.3f s: %s\n", est.eventos, est.omitidos,
+           est.segundos, iguales ? "estado idéntico" : "ESTADO DISTINTO");
+
+    // Escritura cortada: el último registro queda incompleto y se descarta
+    FILE* archivo = fopen(ruta.c_str(), "rb+");
+    if (!archivo) return 1;
+    fseek(archivo, 0, SEEK_END);
+    long tamano = ftell(archivo);
+    fclose(archivo);
+    if (truncate(ruta.c_str(), tamano - 3) != 0) return 1;
+    EstadisticasDiario cortado;
+    reproducir(cortado);
+    bool descartado = cortado.eventos + 1 == est.eventos && cortado.bytesDescartados > 0;
+    printf("diario cortado: %zu eventos, %zu bytes descartados: %s\n", cortado.eventos, cortado.bytesDescartados,
+           descartado ? "solo se pierde el último" : "ERROR");
+
+    remove(ruta.c_str());
+    remove(rutaControl.c_str());
+    return iguales && descartado ? 0 : 1;
+}
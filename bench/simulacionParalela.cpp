@@ -0,0 +1,122 @@
+/**
+ * @file simulacionParalela.cpp
+ * @brief Escalamiento de la simulación de varios días con 1 a N hilos.
+ *
+ * Genera el mismo mercado sintético para cada número de hilos y simula D días
+ * hábiles con K noticias aleatorias por día (simularMercado, con un grupo de
+ * hilos persistente y una barrera por día). Imprime una fila por número de
+ * hilos con el tiempo, la aceleración y la eficiencia respecto a 1 hilo, y
+ * comprueba que precios, historiales y noticias sean idénticos bit a bit a los
+ * de la ejecución con 1 hilo. También comprueba que la simulación no repita los
+ * choques del historial generado: casi ningún rendimiento simulado de una
+ * empresa debe coincidir con uno de los rendimientos de su historial.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread bench/simulacionParalela.cpp -o simulacionParalela
+ * Uso: ./simulacionParalela [empresas] [días] [noticias por día] [hilos máximos] [semilla]
+ */
+#include <chrono>
+#include <cstdio>
+#include "../noticia.h"
+using namespace std;
+
+/// @brief Agrega bytes a un hash FNV-1a de 64 bits.
+static void mezclar(uint64_t& hash, const void* datos, size_t n) {
+    const unsigned char* p = static_cast<const unsigned char*>(datos);
+    for (size_t i = 0; i < n; ++i) hash = (hash ^ p[i]) * 0x100000001b3ULL;
+}
+
+/// @brief Huella del estado: precios actuales, historiales completos, índice por precio y noticias.
+static uint64_t huella(ABBEmpresas& arbol, const ColaPrioridadNoticias& cola) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const Empresa* e : arbol.obtenerEmpresasOrdenadas()) {
+        const HistorialPrecios& h = e->historialPrecios;
+        mezclar(hash, &e->precioActual, sizeof(float));
+        for (size_t i = 0; i < h.size(); ++i) {
+            float precio = h.precio(i);
+            Fecha fecha = h.fecha(i);
+            mezclar(hash, &precio, sizeof(precio));
+            mezclar(hash, &fecha.dias, sizeof(fecha.dias));
+        }
+    }
+    for (const Empresa* e : arbol.buscarEmpresasPorRangoPrecio(0, 1e30f)) mezclar(hash, e->ticker.data(), e->ticker.size());
+    for (const Noticia* n : cola) {
+        mezclar(hash, &n->impacto, sizeof(n->impacto));
+        mezclar(hash, &n->fecha.dias, sizeof(n->fecha.dias));
+        mezclar(hash, n->sectorAfectado.data(), n->sectorAfectado.size());
+    }
+    return hash;
+}
+
+/**
+ * @brief Fracción de días simulados cuyo rendimiento coincide con alguno del historial generado.
+ *
+ * Si la simulación usara los mismos flujos aleatorios que generarMercado,
+ * sus choques normales serían los del historial y muchos rendimientos
+ * logarítmicos coincidirían salvo el redondeo de los precios en float. Con
+ * flujos independientes solo coinciden por azar (del orden de 0,1 %).
+ * @param arbol Mercado ya simulado.
+ * @param diasHistorial Días hábiles que tenía el historial generado.
+ */
+static double fraccionRepetida(const ABBEmpresas& arbol, int diasHistorial) {
+    size_t comparados = 0, repetidos = 0;
+    vector<Fecha> fechas;
+    vector<float> precios;
+    for (const Empresa* e : arbol.obtenerEmpresasOrdenadas()) {
+        e->historialPrecios.cierresEnOrdenDeFecha(fechas, precios);
+        auto retorno = [&](size_t j) { return log((double)precios[j] / precios[j - 1]); };
+        for (size_t k = diasHistorial; k < precios.size() && k < 2 * (size_t)diasHistorial; ++k) {
+            bool repetido = false;
+            for (size_t j = 1; j < (size_t)diasHistorial && !repetido; ++j)
+                repetido = fabs(retorno(k) - retorno(j)) < 1e-6;
+            comparados++;
+            repetidos += repetido;
+        }
+    }
+    return comparados ? (double)repetidos / comparados : 0;
+}
+
+int main(int argc, char** argv) {
+    ConfiguracionMercado config;
+    config.empresas = argc > 1 ? strtoull(argv[1], nullptr, 10) : 5000;
+    int dias = argc > 2 ? atoi(argv[2]) : 1260;
+    int noticiasPorDia = argc > 3 ? atoi(argv[3]) : 4;
+    unsigned maximo = argc > 4 ? (unsigned)atoi(argv[4]) : hilosDisponibles();
+    config.semilla = argc > 5 ? strtoull(argv[5], nullptr, 10) : 7;
+    config.dias = 20;
+    if (maximo == 0) maximo = 1;
+
+    vector<unsigned> cantidades;
+    for (unsigned h = 1; h < maximo; h *= 2) cantidades.push_back(h);
+    cantidades.push_back(maximo);
+
+    printf("%zu empresas, %d días, %d noticias por día\n", config.empresas, dias, noticiasPorDia);
+    printf("hilos | segundos | aceleración | eficiencia | resultado\n");
+    double base = 0;
+    uint64_t esperado = 0;
+    bool iguales = true;
+    for (unsigned hilos : cantidades) {
+        ABBEmpresas arbol(config);
+        ColaPrioridadNoticias cola;
+        GrupoHilos grupo(hilos);
+        Fecha desde = arbol.ultimaFecha().siguienteDiaHabil();
+        auto inicio = chrono::steady_clock::now();
+        simularMercado(arbol, cola, desde, dias, noticiasPorDia, config.semilla, grupo);
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        uint64_t hash = huella(arbol, cola);
+        if (hilos == 1) {
+            base = segundos;
+            esperado = hash;
+            double repetida = fraccionRepetida(arbol, config.dias);
+            printf("rendimientos simulados iguales a uno del historial generado: %.2f%%\n", 100 * repetida);
+            if (repetida > 0.05) {
+                printf("ERROR: la simulación repite los choques del historial generado\n");
+                return 1;
+            }
+        }
+        bool igual = hash == esperado;
+        iguales = iguales && igual;
+        printf("%5u | %8.3f | %11.2f | %9.0f%% | %s\n", hilos, segundos, base / segundos,
+               100 * base / segundos / hilos, igual ? "idéntico" : "DISTINTO");
+    }
+    return iguales ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file vistasNoticias.cpp
+ * @brief Vistas por prioridad y por fecha de ColaPrioridadNoticias contra la fuerza bruta.
+ *
+ * Verificación: con inserciones y extracciones intercaladas, comprueba que el
+ * recorrido por fecha sea el recorrido por prioridad reordenado de forma
+ * estable por fecha, que entreFechas devuelva lo mismo que filtrar todas las
+ * noticias y que recorrer por fecha no altere el orden de extracción.
+ * Medición con 1k, 100k y 1M noticias: insertar, recorrer en cada orden,
+ * copiar y reordenar por fecha (lo que costaría una vista reordenando) y un
+ * rango de 30 días contra filtrar todas las noticias.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread bench/vistasNoticias.cpp -o vistasNoticias
+ * Uso: ./vistasNoticias [desordenadas]
+ *      Con "desordenadas" las fechas de la medición son al azar en 10 años
+ *      en vez de llegar en orden cronológico.
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "../noticia.h"
+using namespace std;
+
+/// @brief Milisegundos transcurridos desde `inicio`.
+static double msDesde(chrono::steady_clock::time_point inicio) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+}
+
+/// @brief Orden esperado por fecha: el de prioridad, reordenado de forma estable.
+static vector<Noticia*> esperadoPorFecha(const ColaPrioridadNoticias& cola) {
+    vector<Noticia*> noticias;
+    cola.obtenerNoticias(noticias);
+    stable_sort(noticias.begin(), noticias.end(), [](const Noticia* a, const Noticia* b) { return a->fecha < b->fecha; });
+    return noticias;
+}
+
+/// @brief Compara ambas vistas y varios rangos de fechas con la fuerza bruta.
+static bool coincide(const ColaPrioridadNoticias& cola, GeneradorAleatorio& azar) {
+    vector<Noticia*> esperado = esperadoPorFecha(cola), recorrido;
+    for (Noticia* n : cola.porOrdenDeFecha()) recorrido.push_back(n);
+    if (recorrido != esperado) return false;
+    for (int q = 0; q < 20; ++q) {
+        Fecha desde = generarFecha((int)azar.menorQue(420) - 10);
+        Fecha hasta = desde + ((int)azar.menorQue(60) - 5);
+        vector<Noticia*> filtradas, rango;
+        for (Noticia* n : esperado) {
+            if (!(n->fecha < desde) && !(hasta < n->fecha)) filtradas.push_back(n);
+        }
+        for (Noticia* n : cola.entreFechas(desde, hasta)) rango.push_back(n);
+        if (rango != filtradas) return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    bool desordenadas = argc > 1 && strcmp(argv[1], "desordenadas") == 0;
+
+    // Verificación con extracciones intercaladas
+    {
+        ColaPrioridadNoticias cola;
+        GeneradorAleatorio azar(5, 2);
+        for (int paso = 0; paso < 20000; ++paso) {
+            if (!cola.estaVacia() && azar.menorQue(3) == 0) {
+                NoticiaExtraida n;
+                cola.extraer(n);
+            } else {
+                cola.insertar(azar.entero(1, 10), "Noticia " + to_string(paso), "",
+                              SECTORES_EMPRESA[azar.menorQue(SECTORES_EMPRESA.size())],
+                              generarFecha(azar.menorQue(400)));
+            }
+            if (paso % 500 == 0 && !coincide(cola, azar)) {
+                printf("ERROR: las vistas por fecha no coinciden en el paso %d\n", paso);
+                return 1;
+            }
+        }
+        // Después de recorrer por fecha, la extracción sigue en orden de prioridad
+        vector<string> esperado;
+        for (const Noticia* n : cola) esperado.push_back(string(n->titulo));
+        for (Noticia* n : cola.porOrdenDeFecha()) (void)n;
+        size_t k = 0;
+        NoticiaExtraida n;
+        while (cola.extraer(n)) {
+            if (k >= esperado.size() || n.titulo != esperado[k++]) {
+                printf("ERROR: la extracción dejó de seguir el orden de prioridad\n");
+                return 1;
+            }
+        }
+        printf("verificación: vistas por fecha, rangos y orden de extracción coinciden con la fuerza bruta\n");
+    }
+
+    printf("fechas %s\n", desordenadas ? "al azar en 10 años" : "en orden cronológico");
+    printf("noticias | insertar | por prioridad | por fecha | copiar y reordenar | rango 30 días | filtrar todas\n");
+    for (int cantidad : {1000, 100000, 1000000}) {
+        vector<NoticiaGenerada> lote = generarLoteNoticias(cantidad, 42, 1);
+        GeneradorAleatorio azar(1, 1);
+        if (desordenadas) {
+            for (NoticiaGenerada& n : lote) n.fecha = generarFecha(azar.menorQue(3650));
+        }
+        ColaPrioridadNoticias cola;
+        auto inicio = chrono::steady_clock::now();
+        for (const NoticiaGenerada& n : lote)
+            cola.insertar(n.impacto, TITULOS_NOTICIA[n.titulo], DESCRIPCIONES_NOTICIA[n.descripcion],
+                          SECTORES_EMPRESA[n.sector], n.fecha, n.esPositiva);
+        double insertar = msDesde(inicio);
+
+        long long suma = 0;
+        inicio = chrono::steady_clock::now();
+        for (const Noticia* n : cola) suma += n->impacto;
+        double prioridad = msDesde(inicio);
+
+        inicio = chrono::steady_clock::now();
+        for (const Noticia* n : cola.porOrdenDeFecha()) suma += n->fecha.dias;
+        double fecha = msDesde(inicio);
+
+        inicio = chrono::steady_clock::now();
+        vector<Noticia*> copia = esperadoPorFecha(cola);
+        double reordenar = msDesde(inicio);
+
+        // Un tramo de 30 días en medio de las fechas de la medición
+        Fecha desde = copia[copia.size() / 2]->fecha, hasta = desde + 30;
+        inicio = chrono::steady_clock::now();
+        size_t enRango = 0;
+        for (const Noticia* n : cola.entreFechas(desde, hasta)) enRango += n->impacto > 0;
+        double rango = msDesde(inicio);
+
+        inicio = chrono::steady_clock::now();
+        size_t filtradas = 0;
+        for (const Noticia* n : cola) filtradas += !(n->fecha < desde) && !(hasta < n->fecha);
+        double filtrar = msDesde(inicio);
+
+        if (enRango != filtradas) {
+            printf("ERROR: el rango de 30 días no coincide con el filtro\n");
+            return 1;
+        }
+        printf("%8d | %5.1f ms | %10.2f ms | %6.2f ms | %15.2f ms | %10.4f ms | %10.2f ms (%zu noticias en el rango)\n",
+               cantidad, insertar, prioridad, fecha, reordenar, rango, filtrar, enRango);
+        if (suma < 0) printf("%lld\n", suma); // evita que los recorridos se eliminen
+    }
+    return 0;
+}
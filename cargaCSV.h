@@ -0,0 +1,239 @@
+#ifndef CARGACSV_H
+#define CARGACSV_H
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "empresa.h"
+#include "fecha.h"
+#include "memoria.h"
+#include "paralelo.h"
+using namespace std;
+
+/**
+ * @brief Resumen de una carga de archivos CSV.
+ */
+struct EstadisticasCargaCSV {
+    size_t archivos = 0;        ///< Archivos leídos
+    size_t archivosFallidos = 0;///< Archivos que no se pudieron abrir
+    size_t bytes = 0;           ///< Bytes leídos
+    size_t filas = 0;           ///< Filas de precios cargadas
+    size_t filasInvalidas = 0;  ///< Filas descartadas por formato
+    size_t filasRepetidas = 0;  ///< Filas descartadas por repetir la fecha de su ticker
+    size_t series = 0;          ///< Tickers cargados
+    double segundos = 0;        ///< Tiempo total (lectura y carga en el árbol)
+
+    /// @brief Rendimiento de la carga en MB/s.
+    double mbPorSegundo() const { return segundos > 0 ? bytes / 1e6 / segundos : 0; }
+    /// @brief Rendimiento de la carga en filas/s.
+    double filasPorSegundo() const { return segundos > 0 ? filas / segundos : 0; }
+};
+
+/**
+ * @brief Compara un campo con un nombre de columna sin distinguir mayúsculas.
+ * @param campo Campo leído.
+ * @param nombre Nombre en minúsculas.
+ * @return true si coinciden.
+ */
+inline bool esColumna(string_view campo, const char* nombre) {
+    size_t n = strlen(nombre);
+    if (campo.size() != n) return false;
+    for (size_t i = 0; i < n; ++i) {
+        char c = campo[i];
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        if (c != nombre[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Interpreta un CSV de precios de cierre diarios.
+ *
+ * Formatos aceptados (separador ',', sin comillas):
+ * - ticker,fecha,cierre
+ * - ticker,fecha,apertura,máximo,mínimo,cierre,volumen (OHLCV; solo se guarda el cierre)
+ * - fecha,cierre (un archivo por empresa; se usa tickerArchivo)
+ * - cualquier orden si la primera fila es un encabezado con columnas
+ *   ticker/symbol, date/fecha, close/cierre y opcionalmente sector; si el
+ *   encabezado no tiene ticker (un archivo por empresa) se usa tickerArchivo.
+ * Los campos se leen como rebanadas del texto original; solo se reservan
+ * cadenas al aparecer un ticker nuevo.
+ * @param texto Contenido del archivo.
+ * @param bytes Tamaño del contenido.
+ * @param tickerArchivo Ticker para archivos sin columna de ticker.
+ * @param salida Series leídas (una por ticker, en orden de aparición).
+ * @param filas Filas válidas leídas (se acumula).
+ * @param invalidas Filas descartadas (se acumula).
+ */
+inline void leerCSVPrecios(const char* texto, size_t bytes, string_view tickerArchivo, vector<SeriePrecios>& salida, size_t& filas, size_t& invalidas) {
+    const int MAX_CAMPOS = 16;
+    int colTicker = 0, colFecha = 1, colCierre = -1, colSector = -1;
+    unordered_map<string_view, size_t> indice;
+    string_view ultimoTicker;
+    size_t ultimaSerie = 0;
+    bool primeraFila = true;
+
+    const char* p = texto;
+    const char* fin = texto + bytes;
+    string_view campos[MAX_CAMPOS];
+    while (p < fin) {
+        const char* finLinea = static_cast<const char*>(memchr(p, '\n', fin - p));
+        if (!finLinea) finLinea = fin;
+        const char* finDatos = finLinea;
+        if (finDatos > p && finDatos[-1] == '\r') finDatos--;
+
+        int numCampos = 0;
+        const char* inicioCampo = p;
+        for (const char* c = p; c <= finDatos && numCampos < MAX_CAMPOS; ++c) {
+            if (c == finDatos || *c == ',') {
+                campos[numCampos++] = string_view(inicioCampo, c - inicioCampo);
+                inicioCampo = c + 1;
+            }
+        }
+        p = finLinea + 1;
+        if (numCampos == 1 && campos[0].empty()) continue;  // Línea vacía
+
+        Fecha fecha;
+        if (primeraFila) {
+            primeraFila = false;
+            if (numCampos == 2 && Fecha::parsear(campos[0].data(), campos[0].size(), fecha)) {
+                // Sin encabezado ni ticker: fecha,cierre
+                colTicker = -1;
+                colFecha = 0;
+                colCierre = 1;
+            } else if (numCampos > colFecha && !Fecha::parsear(campos[colFecha].data(), campos[colFecha].size(), fecha)) {
+                // Encabezado: ubicar las columnas por nombre
+                colTicker = -1;
+                for (int k = 0; k < numCampos; ++k) {
+                    if (esColumna(campos[k], "ticker") || esColumna(campos[k], "symbol")) colTicker = k;
+                    else if (esColumna(campos[k], "date") || esColumna(campos[k], "fecha")) colFecha = k;
+                    else if (esColumna(campos[k], "close") || esColumna(campos[k], "cierre")) colCierre = k;
+                    else if (esColumna(campos[k], "sector")) colSector = k;
+                }
+                continue;
+            }
+        }
+        int cierre = colCierre >= 0 ? colCierre : (numCampos >= 6 ? 5 : 2);
+        if (numCampos <= max(max(colTicker, colFecha), cierre)) {
+            invalidas++;
+            continue;
+        }
+        string_view ticker = colTicker >= 0 ? campos[colTicker] : tickerArchivo;
+        if (ticker.empty() || !Fecha::parsear(campos[colFecha].data(), campos[colFecha].size(), fecha)) {
+            invalidas++;
+            continue;
+        }
+        float precio;
+        const char* inicioPrecio = campos[cierre].data();
+        const char* finPrecio = inicioPrecio + campos[cierre].size();
+        auto leido = from_chars(inicioPrecio, finPrecio, precio);
+        if (leido.ec != errc() || leido.ptr != finPrecio || !(precio > 0)) {
+            invalidas++;
+            continue;
+        }
+
+        // Las filas suelen venir agrupadas por ticker: se evita el hash en el caso común
+        if (ticker != ultimoTicker) {
+            auto it = indice.find(ticker);
+            if (it == indice.end()) {
+                SeriePrecios serie;
+                serie.ticker = string(ticker);
+                if (colSector >= 0 && colSector < numCampos) serie.sector = string(campos[colSector]);
+                salida.push_back(std::move(serie));
+                it = indice.emplace(ticker, salida.size() - 1).first;
+            }
+            ultimoTicker = ticker;
+            ultimaSerie = it->second;
+        }
+        salida[ultimaSerie].fechas.push_back(fecha);
+        salida[ultimaSerie].precios.push_back(precio);
+        filas++;
+    }
+}
+
+/**
+ * @brief Ticker deducido del nombre de un archivo ("datos/aapl.us.csv" -> "AAPL").
+ * @param ruta Ruta del archivo.
+ * @return Nombre del archivo hasta el primer punto, en mayúsculas.
+ */
+inline string tickerDesdeRuta(const string& ruta) {
+    size_t inicio = ruta.find_last_of("/\\");
+    inicio = inicio == string::npos ? 0 : inicio + 1;
+    size_t fin = ruta.find('.', inicio);
+    string ticker = ruta.substr(inicio, fin == string::npos ? string::npos : fin - inicio);
+    for (char& c : ticker) {
+        if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+    }
+    return ticker;
+}
+
+/**
+ * @brief Carga precios históricos desde archivos CSV al árbol de empresas.
+ *
+ * Cada archivo se proyecta en memoria y se interpreta en un hilo distinto;
+ * luego las series se unen por ticker y se cargan con
+ * ABBEmpresas::cargarHistoriales, también en paralelo.
+ * @param arbol Árbol de empresas destino.
+ * @param rutas Archivos CSV a cargar.
+ * @param hilos Número de hilos de trabajo.
+ * @return Estadísticas de la carga (filas, bytes, tiempo y rendimiento).
+ */
+inline EstadisticasCargaCSV cargarCSV(ABBEmpresas& arbol, const vector<string>& rutas, unsigned hilos = hilosDisponibles()) {
+    EstadisticasCargaCSV est;
+    auto inicio = chrono::steady_clock::now();
+    vector<vector<SeriePrecios>> porArchivo(rutas.size());
+    vector<size_t> filas(rutas.size(), 0), invalidas(rutas.size(), 0), bytes(rutas.size(), 0);
+    vector<char> abiertos(rutas.size(), 0);
+    atomic<size_t> siguiente(0);
+    if (hilos == 0) hilos = 1;
+    unsigned hilosLectura = min<size_t>(hilos, max<size_t>(rutas.size(), 1));
+    ejecutarEnParalelo(hilosLectura, [&](unsigned) {
+        // Cada hilo toma el siguiente archivo pendiente: reparte bien archivos de distinto tamaño
+        for (size_t i = siguiente++; i < rutas.size(); i = siguiente++) {
+            ArchivoMapeado archivo(rutas[i]);
+            if (!archivo.abierto()) continue;
+            abiertos[i] = 1;
+            bytes[i] = archivo.tamano();
+            string tickerArchivo = tickerDesdeRuta(rutas[i]);
+            leerCSVPrecios(archivo.inicio(), archivo.tamano(), tickerArchivo, porArchivo[i], filas[i], invalidas[i]);
+        }
+    });
+
+    // Unir las series de un mismo ticker repartidas en varios archivos
+    vector<SeriePrecios> series;
+    unordered_map<string, size_t> indice;
+    for (size_t i = 0; i < rutas.size(); ++i) {
+        if (!abiertos[i]) {
+            cout << "No se pudo abrir el archivo " << rutas[i] << "\n";
+            est.archivosFallidos++;
+            continue;
+        }
+        est.archivos++;
+        est.bytes += bytes[i];
+        est.filas += filas[i];
+        est.filasInvalidas += invalidas[i];
+        for (SeriePrecios& serie : porArchivo[i]) {
+            auto it = indice.find(serie.ticker);
+            if (it == indice.end()) {
+                indice.emplace(serie.ticker, series.size());
+                series.push_back(std::move(serie));
+            } else {
+                SeriePrecios& destino = series[it->second];
+                destino.fechas.insert(destino.fechas.end(), serie.fechas.begin(), serie.fechas.end());
+                destino.precios.insert(destino.precios.end(), serie.precios.begin(), serie.precios.end());
+                if (destino.sector.empty()) destino.sector = serie.sector;
+            }
+        }
+    }
+    est.series = series.size();
+    est.filasRepetidas = arbol.cargarHistoriales(series, hilos);
+    est.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    return est;
+}
+
+#endif
@@ -3,7 +3,12 @@
 #include "empresa.h"
 #include "noticia.h"
 #include "portafolio.h"
+#include "cargaCSV.h"
+#include "snapshot.h"
+#include "diario.h"
+#include "estudioEventos.h"
 #include <set> // <-- Agrega esto para usar std::set
+#include <chrono>
 
 // Añade declaración externa para los sectores de empresa.h
 extern const vector<string> SECTORES_EMPRESA;
@@ -17,6 +22,7 @@ void mostrarMenuPrincipal() {
     cout << " 2. Consultas por sector\n";
     cout << " 3. Simulación y noticias\n";
     cout << " 4. Gestión de portafolio\n"; // <-- Agregado
+    cout << " 5. Guardar estado (instantánea)\n";
     cout << " 0. Salir\n";
     cout << "-----------------------------------------------\n";
     cout << "Seleccione una opción: ";
@@ -63,11 +69,13 @@ void mostrarMenuSimulacion() {
     cout << "\n------ SIMULACIÓN Y NOTICIAS ------\n";
     cout << " 1. Insertar noticia manualmente y ajustar precios\n";
     cout << " 2. Generar noticias aleatorias y simular mercado\n";
-    cout << " 3. Mostrar noticias (por prioridad o fecha)\n";
+    cout << " 3. Mostrar noticias (por prioridad, fecha o rango)\n";
     cout << " 4. Buscar noticias (por sector o palabra clave)\n";
     cout << " 5. Estadísticas y alertas de noticias\n";
     cout << " 6. Ver cambios de todas las empresas dadas las noticias\n";
     cout << " 7. Ver cambios de una empresa en específico dadas las noticias\n";
+    cout << " 8. Configurar umbrales de alerta de crisis por sector\n";
+    cout << " 9. Estudio de eventos (retornos anormales por sector, impacto y signo)\n";
     cout << " 0. Volver al menú principal\n";
     cout << "-----------------------------------\n";
     cout << "Seleccione una opción: ";
@@ -87,26 +95,200 @@ void mostrarMenuPortafolio() {
     cout << "Seleccione una opción: ";
 }
 
+/**
+ * @brief Lee las opciones de línea de comandos del mercado.
+ *
+ * Opciones: --empresas N, --dias M, --inicio AAAA-MM-DD (generan un mercado
+ * sintético), --csv archivo (carga precios reales; se puede repetir),
+ * --cargar archivo (restaura una instantánea guardada), --diario archivo
+ * (registra cada operación y reanuda la sesión tras un cierre inesperado),
+ * --simular D (simula D días hábiles más, en paralelo, antes de empezar) y
+ * --semilla S (hace reproducible cualquier ejecución).
+ * @param argc Cantidad de argumentos.
+ * @param argv Argumentos.
+ * @param config Configuración a completar.
+ * @param sintetico Se pone en true si se pidió un mercado sintético.
+ * @param conSemilla Se pone en true si se indicó la semilla.
+ * @param archivosCSV Archivos CSV a cargar.
+ * @param instantanea Instantánea a restaurar (vacío si no se pidió).
+ * @param rutaDiario Diario de eventos (vacío si no se pidió).
+ * @param diasSimulados Días hábiles a simular antes de empezar (0 si no se pidió).
+ * @return false si algún argumento es inválido.
+ */
+bool leerArgumentos(int argc, char* argv[], ConfiguracionMercado& config, bool& sintetico, bool& conSemilla,
+                    vector<string>& archivosCSV, string& instantanea, string& rutaDiario, int& diasSimulados) {
+    for (int i = 1; i < argc; ++i) {
+        string opcion = argv[i];
+        if (i + 1 >= argc) {
+            cout << "Falta el valor de " << opcion << ".\n";
+            return false;
+        }
+        string valor = argv[++i];
+        char* fin = nullptr;
+        if (opcion == "--empresas") {
+            config.empresas = strtoull(valor.c_str(), &fin, 10);
+            sintetico = true;
+        } else if (opcion == "--dias") {
+            config.dias = (int)strtol(valor.c_str(), &fin, 10);
+            sintetico = true;
+        } else if (opcion == "--simular") {
+            diasSimulados = (int)strtol(valor.c_str(), &fin, 10);
+        } else if (opcion == "--semilla") {
+            config.semilla = strtoull(valor.c_str(), &fin, 10);
+            conSemilla = true;
+        } else if (opcion == "--inicio") {
+            if (!Fecha::parsear(valor, config.inicio)) {
+                cout << "Fecha inválida: " << valor << ". Use el formato YYYY-MM-DD.\n";
+                return false;
+            }
+            sintetico = true;
+            continue;
+        } else if (opcion == "--csv") {
+            archivosCSV.push_back(valor);
+            continue;
+        } else if (opcion == "--cargar") {
+            instantanea = valor;
+            continue;
+        } else if (opcion == "--diario") {
+            rutaDiario = valor;
+            continue;
+        } else {
+            cout << "Opción desconocida: " << opcion << "\n";
+            return false;
+        }
+        if (valor.empty() || *fin != '\0' || valor[0] == '-') {
+            cout << "Valor inválido para " << opcion << ": " << valor << "\n";
+            return false;
+        }
+    }
+    if (sintetico && !archivosCSV.empty()) {
+        cout << "--csv no se puede combinar con un mercado sintético (los historiales se mezclarían).\n";
+        return false;
+    }
+    if (!instantanea.empty() && (sintetico || !archivosCSV.empty())) {
+        cout << "--cargar no se puede combinar con un mercado sintético ni con --csv.\n";
+        return false;
+    }
+    if (diasSimulados > 0 && !instantanea.empty()) {
+        cout << "--simular no se puede combinar con --cargar (la instantánea ya es el estado a continuar).\n";
+        return false;
+    }
+    if (!rutaDiario.empty() && !instantanea.empty()) {
+        cout << "--diario no se puede combinar con --cargar (el diario usa su propia instantánea).\n";
+        return false;
+    }
+    return true;
+}
+
 /**
  * @brief Función principal del programa.
  * 
  * Controla el flujo del sistema de gestión de acciones, mostrando menús y ejecutando las opciones seleccionadas por el usuario.
  * 
+ * @param argc Cantidad de argumentos.
+ * @param argv Opciones del mercado (ver leerArgumentos).
  * @return 0 al finalizar correctamente.
  */
-int main() {
-    ABBEmpresas arbol; ///< Árbol binario de búsqueda que almacena todas las empresas.
+int main(int argc, char* argv[]) {
+    ConfiguracionMercado config;
+    bool sintetico = false, conSemilla = false;
+    vector<string> archivosCSV;
+    string instantanea, rutaDiario;
+    int diasSimulados = 0;
+    if (!leerArgumentos(argc, argv, config, sintetico, conSemilla, archivosCSV, instantanea, rutaDiario, diasSimulados)) {
+        cout << "Uso: " << argv[0] << " [--empresas N] [--dias M] [--inicio AAAA-MM-DD] [--semilla S] [--csv archivo]..."
+             << " [--simular D] [--diario archivo] | --cargar instantanea\n";
+        return 1;
+    }
+    // Con un diario, su instantánea (archivo.snap) guarda el estado del último punto de control
+    string rutaControl = rutaDiario.empty() ? "" : rutaDiario + ".snap";
+    bool reanudar = !rutaDiario.empty() && existeArchivo(rutaControl);
+    if (reanudar) {
+        if (sintetico || !archivosCSV.empty() || diasSimulados > 0) {
+            cout << "El diario " << rutaDiario << " ya tiene una sesión: quite las opciones del mercado para "
+                 << "reanudarla o use otro diario.\n";
+            return 1;
+        }
+        instantanea = rutaControl;
+    }
+    if (!conSemilla) config.semilla = semillaPorTiempo();
+    // Con archivos CSV o una instantánea, y sin mercado sintético, se parte de un mercado vacío
+    bool vacio = !sintetico && (!archivosCSV.empty() || !instantanea.empty());
+    if (vacio) config.empresas = 0;
+    auto inicioCarga = chrono::steady_clock::now();
+    unique_ptr<ABBEmpresas> mercado(sintetico || vacio ? new ABBEmpresas(config) : new ABBEmpresas(config.semilla));
+    ABBEmpresas& arbol = *mercado; ///< Árbol binario de búsqueda que almacena todas las empresas.
+    if (sintetico) {
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicioCarga).count();
+        cout << "Mercado sintético: " << config.empresas << " empresas x " << config.dias
+             << " días hábiles (semilla " << config.semilla << ") generado en " << segundos << " s\n";
+    }
+    if (!archivosCSV.empty()) {
+        EstadisticasCargaCSV carga = cargarCSV(arbol, archivosCSV);
+        cout << "CSV: " << carga.archivos << " archivos, " << carga.series << " tickers, " << carga.filas
+             << " filas (" << carga.filasInvalidas << " inválidas, " << carga.filasRepetidas << " con fecha repetida) en "
+             << carga.segundos << " s: " << carga.mbPorSegundo() << " MB/s, " << carga.filasPorSegundo() << " filas/s\n";
+    }
     ColaPrioridadNoticias colaNoticias; ///< Cola de prioridad para noticias financieras
+    if (diasSimulados > 0) {
+        // Días simulados tras el último precio conocido, con las empresas repartidas entre los núcleos
+        auto inicioSimulacion = chrono::steady_clock::now();
+        GrupoHilos grupo;
+        Fecha desde = arbol.ultimaFecha().siguienteDiaHabil();
+        simularMercado(arbol, colaNoticias, desde, diasSimulados, 1, config.semilla, grupo);
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicioSimulacion).count();
+        cout << "Simulación: " << diasSimulados << " días hábiles desde " << desde << " con " << grupo.tamano()
+             << " hilos en " << segundos << " s\n";
+    }
 
     // --- Portafolio interactivo ---
     string nombreUsuario;
-    cout << "Ingrese su nombre: ";
-    getline(cin, nombreUsuario);
-    float presupuesto;
-    cout << "Ingrese su presupuesto inicial ($): ";
-    cin >> presupuesto;
-    cin.ignore();
+    float presupuesto = 0;
+    if (instantanea.empty()) {
+        cout << "Ingrese su nombre: ";
+        getline(cin, nombreUsuario);
+        cout << "Ingrese su presupuesto inicial ($): ";
+        cin >> presupuesto;
+        cin.ignore();
+    }
     Portafolio usuario(nombreUsuario);
+    uint64_t secuenciaControl = 0;
+    if (!instantanea.empty()) {
+        // Restaurar mercado, noticias y portafolio desde la instantánea
+        if (!SnapshotMercado::cargar(instantanea, arbol, colaNoticias, usuario, presupuesto, &secuenciaControl)) return 1;
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicioCarga).count();
+        cout << "Instantánea " << instantanea << " cargada en " << segundos << " s. Bienvenido de nuevo, "
+             << usuario.obtenerNombre() << ".\n";
+    }
+    EstadoSesion estado{arbol, colaNoticias, usuario, presupuesto};
+    Diario diario;
+    const size_t EVENTOS_POR_CONTROL = 10000; ///< Eventos del diario entre puntos de control automáticos
+    if (!rutaDiario.empty()) {
+        if (!diario.abrir(rutaDiario, secuenciaControl)) return 1;
+        if (reanudar) {
+            // Reaplicar las operaciones posteriores al último punto de control
+            EstadisticasDiario repro = reproducirDiario(rutaDiario, secuenciaControl, estado);
+            cout << "Diario " << rutaDiario << ": " << repro.eventos << " eventos reproducidos en " << repro.segundos
+                 << " s (" << repro.eventosPorSegundo() << " eventos/s).\n";
+        } else if (diario.ultimaSecuencia() > 0) {
+            cout << "Diario " << rutaDiario << ": se descartan eventos sin instantánea.\n";
+        }
+        // Sesión nueva: el estado inicial queda en la instantánea del diario
+        if (!reanudar && !puntoDeControl(diario, rutaControl, estado)) return 1;
+    }
+    colaNoticias.tomarAlertas();  // Las alertas de noticias restauradas ya no son novedad
+    /// Registra un evento en el diario (si hay) y lo aplica al estado
+    auto ejecutar = [&](EventoDiario evento, vector<AjusteNoticia>* lote) {
+        if (diario.abierto()) diario.registrar(evento);
+        aplicarEvento(evento, estado, lote, true);
+    };
+    /// Confirma en el disco los eventos de la operación y hace un punto de control si el diario creció
+    auto confirmar = [&]() {
+        if (!diario.abierto()) return;
+        diario.confirmar();
+        if (diario.eventosSinControl() >= EVENTOS_POR_CONTROL) puntoDeControl(diario, rutaControl, estado);
+    };
+    GeneradorAleatorio generadorNoticias(arbol.semilla(), hashTexto("noticias")); ///< Semillas de los lotes de noticias aleatorias
 
     int opcionPrincipal;
     do {
@@ -122,9 +304,8 @@ int main() {
                 cin.ignore();
                 if (opcionEmpresa == 1) { 
                     /// Buscar empresa por ticker y mostrar su información
-                    vector<Empresa*> lista = arbol.obtenerEmpresasOrdenadas();
                     cout << "Empresas disponibles:\n";
-                    for (auto e : lista) {
+                    for (auto e : arbol) {
                         cout << "  " << e->ticker << " - " << e->nombre << endl;
                     }
                     string ticker;
@@ -149,17 +330,9 @@ int main() {
                         cout << "------------------------------------------\n";
                         cout << "   Fecha       | Precio de cierre\n";
                         cout << "------------------------------------------\n";
-                        NodoPrecio* actual = emp->historialPrecios.cabeza;
-                        vector<NodoPrecio*> historial;
-                        while (actual) {
-                            historial.push_back(actual);
-                            actual = actual->siguiente;
-                        }
-                        for (int i = historial.size() - 1; i >= 0; --i) {
-                            for (int f = 0; f < 10 && historial[i]->fecha[f] != '\0'; ++f)
-                                cout << historial[i]->fecha[f];
-                            for (int f = historial[i]->fecha.size(); f < 12; ++f) cout << " ";
-                            cout << "| " << historial[i]->precioCierre << endl;
+                        const HistorialPrecios& historial = emp->historialPrecios;
+                        for (size_t i = 0; i < historial.size(); ++i) {
+                            cout << historial.fecha(i) << "  | " << historial.precio(i) << endl;
                         }
                         cout << "------------------------------------------\n";
                         int dias;
@@ -200,18 +373,7 @@ int main() {
                 cin.ignore();
                 if (opcionSector == 1) { 
                     /// Imprimir todas las empresas de un sector específico
-                    vector<Empresa*> lista = arbol.obtenerEmpresasOrdenadas();
-                    vector<string> sectores;
-                    for (auto e : lista) {
-                        bool existe = false;
-                        for (size_t i = 0; i < sectores.size(); ++i) {
-                            if (sectores[i] == e->sector) {
-                                existe = true;
-                                break;
-                            }
-                        }
-                        if (!existe) sectores.push_back(e->sector);
-                    }
+                    vector<string> sectores = arbol.obtenerSectores();
                     cout << "Sectores disponibles:\n";
                     for (size_t i = 0; i < sectores.size(); ++i) {
                         cout << "  - " << sectores[i] << endl;
@@ -221,24 +383,14 @@ int main() {
                     arbol.imprimirEmpresasPorSector(sector);
                 } else if (opcionSector == 2) { 
                     /// Mostrar el promedio del precio actual de las acciones por sector
-                    vector<Empresa*> lista = arbol.obtenerEmpresasOrdenadas();
-                    vector<string> sectores;
-                    for (auto e : lista) {
-                        bool existe = false;
-                        for (size_t i = 0; i < sectores.size(); ++i) {
-                            if (sectores[i] == e->sector) {
-                                existe = true;
-                                break;
-                            }
-                        }
-                        if (!existe) sectores.push_back(e->sector);
-                    }
+                    vector<string> sectores = arbol.obtenerSectores();
                     cout << "-----------------------------------------------\n";
                     cout << " Promedio del precio de acciones por sector\n";
                     cout << "-----------------------------------------------\n";
                     for (size_t i = 0; i < sectores.size(); ++i) {
-                        float promedio = arbol.promedioPrecioPorSector(sectores[i]);
-                        cout << " " << sectores[i] << ": " << promedio << endl;
+                        const AgregadoSector& agregado = arbol.agregadoPorSector(sectores[i]);
+                        cout << " " << sectores[i] << ": " << agregado.promedio()
+                             << " (mín " << agregado.minimo() << ", máx " << agregado.maximo() << ")" << endl;
                     }
                     cout << "-----------------------------------------------\n";
                 }
@@ -253,7 +405,7 @@ int main() {
                 if (opcionSim == 1) {
                     // Insertar noticia manualmente y ajustar precios
                     int impacto;
-                    string titulo, descripcion, sector, fecha;
+                    string titulo, descripcion, sector, textoFecha;
                     cout << "Impacto (1-10): "; cin >> impacto; cin.ignore();
                     cout << "Título: "; getline(cin, titulo);
                     cout << "Descripción: "; getline(cin, descripcion);
@@ -262,72 +414,78 @@ int main() {
                         cout << "  - " << s << endl;
                     }
                     cout << "Sector: "; getline(cin, sector);
-                    cout << "Fecha (YYYY-MM-DD): "; getline(cin, fecha);
-                    colaNoticias.insertar(impacto, titulo, descripcion, sector, fecha);
-                    arbol.ajustarPreciosPorNoticia(sector, impacto, fecha);
+                    cout << "Fecha (YYYY-MM-DD): "; getline(cin, textoFecha);
+                    Fecha fecha;
+                    if (!Fecha::parsear(textoFecha, fecha)) {
+                        cout << "Fecha inválida. Use el formato YYYY-MM-DD.\n";
+                        continue;
+                    }
+                    ejecutar(EventoDiario::noticia(impacto, titulo, descripcion, sector, fecha), nullptr);
+                    confirmar();
                     cout << "\nNoticia generada y precios ajustados.\n";
+                    mostrarAlertasCrisis(colaNoticias.tomarAlertas(), colaNoticias.detectorCrisis());
                 } else if (opcionSim == 2) {
                     // Generar noticias aleatorias y simular mercado
                     int cantidad;
                     cout << "Cantidad de noticias aleatorias a generar: ";
                     cin >> cantidad;
                     cin.ignore();
-                    vector<string> titulos = {
-                        "Caída del dólar", "Nuevo impuesto", "Reforma pensional", "Crisis energética",
-                        "Inversión extranjera", "Caída de acciones tecnológicas", "Sube el petróleo",
-                        "Aumento del salario mínimo", "Devaluación del peso", "Acuerdo comercial firmado"
-                    };
-                    vector<string> descripciones = {
-                        "Los mercados reaccionan ante la noticia.",
-                        "Expertos prevén cambios importantes en el comportamiento bursátil.",
-                        "Los sectores económicos muestran señales de volatilidad.",
-                        "Los analistas recomiendan cautela a los inversionistas.",
-                        "Impacto inmediato esperado en el mercado accionario."
-                    };
                     cout << "\nNoticias generadas y ajustes aplicados:\n";
-                    for (int i = 0; i < cantidad; ++i) {
-                        int impacto = rand() % 10 + 1;
-                        string titulo = titulos[rand() % titulos.size()];
-                        string descripcion = descripciones[rand() % descripciones.size()];
-                        string sector = SECTORES_EMPRESA[rand() % SECTORES_EMPRESA.size()];
-                        string fecha = generarFecha(i);
-                        colaNoticias.insertar(impacto, titulo, descripcion, sector, fecha);
-                        arbol.ajustarPreciosPorNoticia(sector, impacto, fecha);
-                        cout << "  [" << fecha << "] (Impacto: " << impacto << ") " << titulo << " - " << sector << endl;
-                        mostrarAjusteSector(sector, calcularPorcentajeAjuste(impacto));
+                    vector<AjusteNoticia> lote;
+                    for (const NoticiaGenerada& n : generarLoteNoticias(cantidad, generadorNoticias())) {
+                        const string& titulo = TITULOS_NOTICIA[n.titulo];
+                        const string& sector = SECTORES_EMPRESA[n.sector];
+                        ejecutar(EventoDiario::noticia(n.impacto, titulo, DESCRIPCIONES_NOTICIA[n.descripcion], sector, n.fecha),
+                                 &lote);
+                        cout << "  [" << n.fecha << "] (Impacto: " << n.impacto << ") " << titulo << " - " << sector << endl;
+                        mostrarAjusteSector(sector, calcularPorcentajeAjuste(n.impacto));
+                        mostrarAlertasCrisis(colaNoticias.tomarAlertas(), colaNoticias.detectorCrisis());
                     }
+                    // Todo el lote se aplica en una sola pasada por empresa, repartida entre los núcleos
+                    arbol.ajustarPreciosPorNoticias(lote, hilosDisponibles());
+                    confirmar();  // Un solo grupo en el diario para todo el lote
                     cout << "Noticias aleatorias generadas y precios ajustados.\n";
                 } else if (opcionSim == 3) {
                     // Mostrar noticias (elige orden)
                     int subop;
-                    cout << "1. Por prioridad (impacto)\n2. Por fecha\nSeleccione: ";
+                    cout << "1. Por prioridad (impacto)\n2. Por fecha\n3. Por rango de fechas\nSeleccione: ";
                     cin >> subop; cin.ignore();
                     if (subop == 1) {
                         colaNoticias.mostrar();
                     } else if (subop == 2) {
-                        colaNoticias.ordenarPorFecha();
-                        colaNoticias.mostrar();
+                        colaNoticias.mostrarPorFecha();
+                    } else if (subop == 3) {
+                        string textoDesde, textoHasta;
+                        Fecha desde, hasta;
+                        cout << "Desde (YYYY-MM-DD): "; getline(cin, textoDesde);
+                        cout << "Hasta (YYYY-MM-DD): "; getline(cin, textoHasta);
+                        if (!Fecha::parsear(textoDesde, desde) || !Fecha::parsear(textoHasta, hasta)) {
+                            cout << "Fecha inválida. Use el formato YYYY-MM-DD.\n";
+                        } else {
+                            colaNoticias.mostrarEntreFechas(desde, hasta);
+                        }
                     }
                 } else if (opcionSim == 4) {
                     // Buscar noticias
                     int subop;
-                    cout << "1. Por sector\n2. Por palabra clave\nSeleccione: ";
+                    cout << "1. Por sector\n2. Por palabras clave (todas)\n3. Por palabras clave (alguna)\nSeleccione: ";
                     cin >> subop; cin.ignore();
                     if (subop == 1) {
                         string sector;
                         cout << "Sector: "; getline(cin, sector);
                         colaNoticias.buscarPorSector(sector);
-                    } else if (subop == 2) {
-                        string palabra;
-                        cout << "Palabra clave: "; getline(cin, palabra);
-                        colaNoticias.buscarPorPalabraClave(palabra);
+                    } else if (subop == 2 || subop == 3) {
+                        string palabras;
+                        cout << "Palabras clave: "; getline(cin, palabras);
+                        colaNoticias.buscarPorPalabraClave(palabras, subop == 2);
                     }
                 } else if (opcionSim == 5) {
                     // Estadísticas y alertas
                     float promedio = colaNoticias.promedioImpacto();
                     cout << "Impacto promedio de las noticias: " << promedio << endl;
+                    mostrarVentanasCrisis(colaNoticias.detectorCrisis());
                     if (colaNoticias.hayAlertaDeCrisis()) {
-                        cout << "ALERTA: Se detecta posible crisis. Hay múltiples noticias de alto impacto.\n";
+                        cout << "ALERTA: Se detecta posible crisis. Hay sectores con noticias de alto impacto recientes.\n";
                     } else {
                         cout << "No hay señales de crisis por ahora.\n";
                     }
@@ -337,6 +495,37 @@ int main() {
                 } else if (opcionSim == 7) {
                     // Mostrar cambios de una empresa por noticias
                     mostrarCambiosPorNoticiasEmpresa(arbol, colaNoticias);
+                } else if (opcionSim == 8) {
+                    // Configurar umbrales de alerta de un sector (o de todos)
+                    string sector;
+                    UmbralCrisis umbral;
+                    cout << "Sector (vacío para todos): "; getline(cin, sector);
+                    cout << "Noticias de impacto >= " << colaNoticias.detectorCrisis().impactoDeAlerta() << " en "
+                         << colaNoticias.detectorCrisis().diasVentanaCorta() << " días hábiles (0 desactiva): ";
+                    cin >> umbral.altasVentanaCorta;
+                    cout << "Impacto acumulado en " << colaNoticias.detectorCrisis().diasVentanaLarga()
+                         << " días hábiles (0 desactiva): ";
+                    cin >> umbral.sumaVentanaLarga;
+                    cin.ignore();
+                    // Por el diario, para que los umbrales sobrevivan a un cierre inesperado
+                    ejecutar(EventoDiario::umbralCrisis(sector, umbral), nullptr);
+                    confirmar();
+                    cout << "Umbrales actualizados.\n";
+                } else if (opcionSim == 9) {
+                    // Estudio de eventos sobre las noticias de la cola
+                    ConfiguracionEstudio config;
+                    int antes, despues;
+                    cout << "Días de mercado antes de la noticia (ej. 5): "; cin >> antes;
+                    cout << "Días de mercado después de la noticia (ej. 10): "; cin >> despues;
+                    cout << "Días de la ventana de estimación (ej. 60): "; cin >> config.estimacion;
+                    cin.ignore();
+                    config.inicio = -antes;
+                    config.fin = despues;
+                    if (!config.valida()) {
+                        cout << "Ventanas inválidas.\n";
+                    } else {
+                        mostrarEstudioDeEventos(estudioDeEventos(arbol, colaNoticias, config));
+                    }
                 }
             } while (opcionSim != 0);
         } else if (opcionPrincipal == 4) {
@@ -368,9 +557,8 @@ int main() {
                     } else if (total > presupuesto) {
                         cout << "No tiene suficiente presupuesto. Total requerido: $" << total << ", disponible: $" << presupuesto << endl;
                     } else {
-                        presupuesto -= total;
-                        for (int i = 0; i < cantidad; ++i)
-                            usuario.agregarActivo(emp->ticker);
+                        ejecutar(EventoDiario::compra(emp->ticker, cantidad, emp->precioActual), nullptr);
+                        confirmar();
                         cout << "Compra realizada. Presupuesto restante: $" << presupuesto << endl;
                     }
                 } else if (opPort == 2) {
@@ -395,10 +583,8 @@ int main() {
                     if (cantidad <= 0 || cantidad > enPortafolio) {
                         cout << "Cantidad inválida. Usted posee " << enPortafolio << " acciones de " << ticker << ".\n";
                     } else {
-                        for (int i = 0; i < cantidad; ++i)
-                            usuario.eliminarActivo(ticker);
-                        float total = emp->precioActual * cantidad;
-                        presupuesto += total;
+                        ejecutar(EventoDiario::venta(ticker, cantidad, emp->precioActual), nullptr);
+                        confirmar();
                         cout << "Venta realizada. Presupuesto actual: $" << presupuesto << endl;
                     }
                 } else if (opPort == 3) {
@@ -416,14 +602,13 @@ int main() {
                     cin >> subop;
                     cin.ignore();
 
-                    vector<Empresa*> todas = arbol.obtenerEmpresasOrdenadas();
                     vector<string> activos = usuario.obtenerActivos();
                     set<string> yaPosee(activos.begin(), activos.end());
 
                     if (subop == 1) {
                         // Todas las recomendaciones
                         bool alguna = false;
-                        for (auto e : todas) {
+                        for (auto e : arbol) {
                             if (yaPosee.find(e->ticker) == yaPosee.end()) {
                                 cout << "- " << e->ticker << " (" << e->nombre << ")\n";
                                 usuario.recomendarCompra(e->ticker, arbol, colaNoticias);
@@ -448,8 +633,8 @@ int main() {
                         } else {
                             string sectorSel = SECTORES_EMPRESA[idxSector-1];
                             bool alguna = false;
-                            for (auto e : todas) {
-                                if (yaPosee.find(e->ticker) == yaPosee.end() && e->sector == sectorSel) {
+                            for (auto e : arbol.obtenerEmpresasPorSector(sectorSel)) {
+                                if (yaPosee.find(e->ticker) == yaPosee.end()) {
                                     cout << "- " << e->ticker << " (" << e->nombre << ")\n";
                                     usuario.recomendarCompra(e->ticker, arbol, colaNoticias);
                                     alguna = true;
@@ -478,6 +663,19 @@ int main() {
                     }
                 }
             } while (opPort != 0);
+        } else if (opcionPrincipal == 5) {
+            /// Guardar el estado completo para restaurarlo con --cargar
+            string ruta;
+            cout << "Archivo de la instantánea: ";
+            getline(cin, ruta);
+            auto inicioGuardado = chrono::steady_clock::now();
+            if (SnapshotMercado::guardar(ruta, arbol, colaNoticias, usuario, presupuesto)) {
+                double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicioGuardado).count();
+                cout << "Estado guardado en " << ruta << " (" << segundos << " s). Use --cargar " << ruta
+                     << " para restaurarlo.\n";
+            } else {
+                cout << "No se pudo guardar el estado en " << ruta << ".\n";
+            }
         }
     } while (opcionPrincipal != 0);
     cout << "Saliendo...\n";
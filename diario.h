@@ -0,0 +1,598 @@
+#ifndef DIARIO_H
+#define DIARIO_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "empresa.h"
+#include "noticia.h"
+#include "portafolio.h"
+#include "memoria.h"
+#include "snapshot.h"
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+/**
+ * @brief CRC-32 (polinomio 0xEDB88320, el de zip y Ethernet) con tabla de 256 entradas.
+ * @param datos Bytes a resumir.
+ * @param n Cantidad de bytes.
+ * @return CRC de los datos.
+ */
+inline uint32_t crc32(const void* datos, size_t n) {
+    static const vector<uint32_t> TABLA = [] {
+        vector<uint32_t> tabla(256);
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            tabla[i] = c;
+        }
+        return tabla;
+    }();
+    const unsigned char* p = static_cast<const unsigned char*>(datos);
+    uint32_t c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < n; ++i) c = TABLA[(c ^ p[i]) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+/**
+ * @brief Tipos de evento que cambian el estado de la sesión.
+ */
+enum TipoEvento : uint8_t {
+    EVENTO_COMPRA = 1,           ///< Compra de acciones
+    EVENTO_VENTA = 2,            ///< Venta de acciones
+    EVENTO_NOTICIA = 3,          ///< Noticia insertada (y su ajuste de precios)
+    EVENTO_UMBRAL_CRISIS = 4     ///< Umbral de alerta de crisis de un sector (o el general)
+};
+
+/**
+ * @brief Evento del diario. Solo se usan los campos de su tipo.
+ */
+struct EventoDiario {
+    TipoEvento tipo;
+    uint64_t secuencia = 0;  ///< Número de evento (lo asigna Diario::registrar)
+    // Compra y venta
+    string ticker;
+    int cantidad = 0;
+    float precio = 0;        ///< Precio por acción al momento de la operación
+    // Noticia
+    int impacto = 0;
+    string titulo;
+    string descripcion;
+    string sector;
+    Fecha fecha;
+    bool esPositiva = true;
+    // Umbral de crisis (con `sector`; vacío = umbral general)
+    UmbralCrisis umbral;
+
+    /// @brief Evento de compra de acciones.
+    static EventoDiario compra(const string& ticker, int cantidad, float precio) {
+        EventoDiario e;
+        e.tipo = EVENTO_COMPRA;
+        e.ticker = ticker;
+        e.cantidad = cantidad;
+        e.precio = precio;
+        return e;
+    }
+
+    /// @brief Evento de venta de acciones.
+    static EventoDiario venta(const string& ticker, int cantidad, float precio) {
+        EventoDiario e = compra(ticker, cantidad, precio);
+        e.tipo = EVENTO_VENTA;
+        return e;
+    }
+
+    /// @brief Evento de noticia.
+    static EventoDiario noticia(int impacto, const string& titulo, const string& descripcion, const string& sector,
+                                Fecha fecha, bool esPositiva = true) {
+        EventoDiario e;
+        e.tipo = EVENTO_NOTICIA;
+        e.impacto = impacto;
+        e.titulo = titulo;
+        e.descripcion = descripcion;
+        e.sector = sector;
+        e.fecha = fecha;
+        e.esPositiva = esPositiva;
+        return e;
+    }
+
+    /// @brief Evento de cambio de umbral de crisis (sector vacío = umbral general).
+    static EventoDiario umbralCrisis(const string& sector, const UmbralCrisis& umbral) {
+        EventoDiario e;
+        e.tipo = EVENTO_UMBRAL_CRISIS;
+        e.sector = sector;
+        e.umbral = umbral;
+        return e;
+    }
+};
+
+/**
+ * @brief Resultado de recorrer un diario.
+ */
+struct EstadisticasDiario {
+    size_t eventos = 0;        ///< Eventos aplicados
+    size_t omitidos = 0;       ///< Eventos ya incluidos en la instantánea
+    size_t bytes = 0;          ///< Bytes válidos del diario
+    size_t bytesDescartados = 0; ///< Bytes finales incompletos o dañados (escritura cortada)
+    uint64_t ultimaSecuencia = 0; ///< Secuencia del último evento válido
+    double segundos = 0;       ///< Tiempo de la reproducción
+
+    /// @brief Rendimiento de la reproducción en eventos/s.
+    double eventosPorSegundo() const { return segundos > 0 ? eventos / segundos : 0; }
+};
+
+/**
+ * @brief Diario binario de solo anexado con confirmación en grupo.
+ *
+ * Formato: cabecera de 16 bytes ("MERCDIAR", versión, reservado) seguida de
+ * registros [tamaño (32 bits)][CRC-32 (32 bits)][secuencia (64 bits)][tipo (8 bits)][datos],
+ * donde el tamaño y el CRC cubren desde la secuencia hasta el final de los datos.
+ * Un corte de energía solo puede dejar incompleto el último grupo: la lectura
+ * se detiene en el primer registro incompleto o con CRC inválido, y abrir()
+ * recorta esa cola antes de seguir escribiendo.
+ *
+ * registrar() solo acumula el registro en memoria; confirmar() escribe todo
+ * lo pendiente con una sola escritura y un solo fdatasync, de modo que el costo
+ * de sincronizar con el disco se reparte entre todos los eventos del grupo.
+ */
+class Diario {
+public:
+    static const uint32_t VERSION = 1;
+    /// Tamaño de la cabecera del archivo
+    static const size_t TAMANO_CABECERA = 16;
+    /// Tamaño del encabezado de cada registro (tamaño y CRC)
+    static const size_t TAMANO_ENCABEZADO = 8;
+
+private:
+    /// Ruta del archivo
+    string ruta;
+    /// Descriptor del archivo (-1 si está cerrado)
+    int descriptor;
+    /// Registros codificados pendientes de confirmar
+    vector<char> pendiente;
+    /// Eventos en el buffer pendiente
+    size_t eventosPendientes;
+    /// Eventos por grupo: al alcanzarlo, registrar() confirma solo
+    size_t tamanoGrupo;
+    /// Secuencia que recibirá el próximo evento
+    uint64_t siguienteSecuencia;
+    /// Eventos confirmados desde la última llamada a reiniciar()
+    size_t eventosDesdeReinicio;
+    /// Totales de la sesión
+    size_t totalEventos, totalConfirmaciones, totalBytes;
+
+    /// @brief Agrega bytes al buffer pendiente.
+    void anexar(const void* datos, size_t n) {
+        const char* p = static_cast<const char*>(datos);
+        pendiente.insert(pendiente.end(), p, p + n);
+    }
+
+    /// @brief Agrega un valor de tipo trivial al buffer pendiente.
+    template <typename T>
+    void anexarValor(const T& v) { anexar(&v, sizeof(T)); }
+
+    /// @brief Agrega un texto (longitud de 32 bits y caracteres) al buffer pendiente.
+    void anexarTexto(const string& s) {
+        anexarValor<uint32_t>(s.size());
+        anexar(s.data(), s.size());
+    }
+
+    /// @brief Escribe todos los bytes, reintentando escrituras parciales.
+    bool escribirTodo(const char* datos, size_t n) {
+        while (n > 0) {
+#ifdef _WIN32
+            int escrito = _write(descriptor, datos, (unsigned)min<size_t>(n, 1u << 30));
+#else
+            ssize_t escrito = write(descriptor, datos, n);
+#endif
+            if (escrito <= 0) return false;
+            datos += escrito;
+            n -= escrito;
+        }
+        return true;
+    }
+
+    /// @brief Fuerza al disco los datos escritos.
+    bool sincronizar() {
+#ifdef _WIN32
+        return _commit(descriptor) == 0;
+#elif defined(__APPLE__)
+        return fsync(descriptor) == 0;
+#else
+        return fdatasync(descriptor) == 0;
+#endif
+    }
+
+    /// @brief Recorta el archivo a un tamaño dado.
+    bool recortar(size_t tamano) {
+#ifdef _WIN32
+        return _chsize_s(descriptor, tamano) == 0 && _lseeki64(descriptor, tamano, SEEK_SET) >= 0;
+#else
+        return ftruncate(descriptor, tamano) == 0 && lseek(descriptor, tamano, SEEK_SET) >= 0;
+#endif
+    }
+
+    /// @brief Interpreta los datos de un registro ya verificado.
+    static bool decodificar(const char* datos, size_t n, EventoDiario& evento) {
+        LectorBinario entrada(datos, n);
+        evento = EventoDiario();
+        evento.secuencia = entrada.valor<uint64_t>();
+        evento.tipo = (TipoEvento)entrada.valor<uint8_t>();
+        if (evento.tipo == EVENTO_COMPRA || evento.tipo == EVENTO_VENTA) {
+            evento.ticker = entrada.texto();
+            evento.cantidad = entrada.valor<int32_t>();
+            evento.precio = entrada.valor<float>();
+        } else if (evento.tipo == EVENTO_NOTICIA) {
+            evento.impacto = entrada.valor<int32_t>();
+            evento.titulo = entrada.texto();
+            evento.descripcion = entrada.texto();
+            evento.sector = entrada.texto();
+            evento.fecha = Fecha(entrada.valor<int32_t>());
+            evento.esPositiva = entrada.valor<uint8_t>() != 0;
+        } else if (evento.tipo == EVENTO_UMBRAL_CRISIS) {
+            evento.sector = entrada.texto();
+            evento.umbral.altasVentanaCorta = entrada.valor<int32_t>();
+            evento.umbral.sumaVentanaLarga = entrada.valor<int32_t>();
+        } else {
+            entrada.invalidar();
+        }
+        return entrada.correcto();
+    }
+
+    /**
+     * @brief Recorre los registros válidos de un diario en memoria.
+     * @param datos Contenido del archivo.
+     * @param n Tamaño del contenido.
+     * @param funcion Invocada como funcion(evento) por cada registro válido, en orden.
+     * @return Bytes válidos (cabecera incluida), o 0 si la cabecera no es de un diario.
+     */
+    template <typename F>
+    static size_t recorrer(const char* datos, size_t n, F funcion) {
+        if (n < TAMANO_CABECERA || memcmp(datos, "MERCDIAR", 8) != 0) return 0;
+        uint32_t version;
+        memcpy(&version, datos + 8, sizeof(version));
+        if (version != VERSION) return 0;
+        size_t pos = TAMANO_CABECERA;
+        EventoDiario evento;
+        while (n - pos >= TAMANO_ENCABEZADO) {
+            uint32_t tamano, crc;
+            memcpy(&tamano, datos + pos, 4);
+            memcpy(&crc, datos + pos + 4, 4);
+            const char* carga = datos + pos + TAMANO_ENCABEZADO;
+            if (tamano > n - pos - TAMANO_ENCABEZADO || crc32(carga, tamano) != crc) break;
+            if (!decodificar(carga, tamano, evento)) break;
+            funcion(evento);
+            pos += TAMANO_ENCABEZADO + tamano;
+        }
+        return pos;
+    }
+
+public:
+    /**
+     * @brief Constructor.
+     * @param tamanoGrupo Eventos por grupo antes de confirmar automáticamente.
+     */
+    explicit Diario(size_t tamanoGrupo = 256)
+        : descriptor(-1), eventosPendientes(0), tamanoGrupo(tamanoGrupo ? tamanoGrupo : 1), siguienteSecuencia(1),
+          eventosDesdeReinicio(0), totalEventos(0), totalConfirmaciones(0), totalBytes(0) {}
+
+    Diario(const Diario&) = delete;
+    Diario& operator=(const Diario&) = delete;
+
+    /// @brief Destructor. Confirma lo pendiente y cierra el archivo.
+    ~Diario() { cerrar(); }
+
+    /**
+     * @brief Abre (o crea) el diario para seguir anexando.
+     *
+     * Si el archivo termina en un registro incompleto o dañado, se recorta
+     * hasta el último registro válido.
+     * @param rutaArchivo Ruta del diario.
+     * @param secuenciaMinima Secuencias ya usadas (por ejemplo, la de la instantánea):
+     *        los eventos nuevos reciben números mayores.
+     * @return false (con un mensaje) si no se pudo abrir o el archivo no es un diario.
+     */
+    bool abrir(const string& rutaArchivo, uint64_t secuenciaMinima = 0) {
+        cerrar();
+        ruta = rutaArchivo;
+        uint64_t ultima = 0;
+        size_t valido = 0, tamano = 0;
+        {
+            ArchivoMapeado existente(ruta);
+            tamano = existente.abierto() ? existente.tamano() : 0;
+            if (tamano > 0) {
+                valido = recorrer(existente.inicio(), tamano, [&](const EventoDiario& e) { ultima = e.secuencia; });
+                if (valido == 0) {
+                    cout << "El archivo " << ruta << " no es un diario compatible.\n";
+                    return false;
+                }
+            }
+        }
+#ifdef _WIN32
+        descriptor = _open(ruta.c_str(), _O_RDWR | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        descriptor = open(ruta.c_str(), O_RDWR | O_CREAT, 0644);
+#endif
+        if (descriptor < 0) {
+            cout << "No se pudo abrir el diario " << ruta << "\n";
+            return false;
+        }
+        if (valido == 0) {
+            // Diario nuevo: escribir la cabecera
+            char cabecera[TAMANO_CABECERA] = {};
+            memcpy(cabecera, "MERCDIAR", 8);
+            uint32_t version = VERSION;
+            memcpy(cabecera + 8, &version, sizeof(version));
+            if (!recortar(0) || !escribirTodo(cabecera, sizeof(cabecera)) || !sincronizar()) {
+                cout << "No se pudo escribir el diario " << ruta << "\n";
+                cerrar();
+                return false;
+            }
+        } else {
+            if (valido < tamano) {
+                cout << "Diario " << ruta << ": se descartan " << tamano - valido
+                     << " bytes de una escritura incompleta.\n";
+            }
+            if (!recortar(valido) || (valido < tamano && !sincronizar())) {
+                cout << "No se pudo reparar el diario " << ruta << "\n";
+                cerrar();
+                return false;
+            }
+        }
+        siguienteSecuencia = max(ultima, secuenciaMinima) + 1;
+        eventosDesdeReinicio = 0;
+        return true;
+    }
+
+    /// @brief Indica si el diario está abierto.
+    bool abierto() const { return descriptor >= 0; }
+
+    /**
+     * @brief Agrega un evento al grupo pendiente y le asigna su secuencia.
+     *
+     * El evento no es durable hasta la siguiente confirmación (explícita o al
+     * completarse el grupo).
+     * @param evento Evento a registrar.
+     * @return Secuencia asignada.
+     */
+    uint64_t registrar(EventoDiario& evento) {
+        evento.secuencia = siguienteSecuencia++;
+        size_t inicio = pendiente.size();
+        anexarValor<uint32_t>(0);  // Tamaño y CRC se completan al final
+        anexarValor<uint32_t>(0);
+        anexarValor(evento.secuencia);
+        anexarValor<uint8_t>(evento.tipo);
+        if (evento.tipo == EVENTO_COMPRA || evento.tipo == EVENTO_VENTA) {
+            anexarTexto(evento.ticker);
+            anexarValor<int32_t>(evento.cantidad);
+            anexarValor(evento.precio);
+        } else if (evento.tipo == EVENTO_NOTICIA) {
+            anexarValor<int32_t>(evento.impacto);
+            anexarTexto(evento.titulo);
+            anexarTexto(evento.descripcion);
+            anexarTexto(evento.sector);
+            anexarValor(evento.fecha.dias);
+            anexarValor<uint8_t>(evento.esPositiva);
+        } else if (evento.tipo == EVENTO_UMBRAL_CRISIS) {
+            anexarTexto(evento.sector);
+            anexarValor<int32_t>(evento.umbral.altasVentanaCorta);
+            anexarValor<int32_t>(evento.umbral.sumaVentanaLarga);
+        }
+        uint32_t tamano = pendiente.size() - inicio - TAMANO_ENCABEZADO;
+        uint32_t crc = crc32(pendiente.data() + inicio + TAMANO_ENCABEZADO, tamano);
+        memcpy(pendiente.data() + inicio, &tamano, 4);
+        memcpy(pendiente.data() + inicio + 4, &crc, 4);
+        if (++eventosPendientes >= tamanoGrupo) confirmar();
+        return evento.secuencia;
+    }
+
+    /**
+     * @brief Escribe el grupo pendiente y lo fuerza al disco (una escritura y un fdatasync).
+     * @return true si el grupo quedó en el disco (o no había nada pendiente).
+     */
+    bool confirmar() {
+        if (eventosPendientes == 0) return true;
+        if (descriptor < 0) return false;
+        bool correcto = escribirTodo(pendiente.data(), pendiente.size()) && sincronizar();
+        if (!correcto) cout << "Error al escribir el diario " << ruta << "\n";
+        totalEventos += eventosPendientes;
+        totalBytes += pendiente.size();
+        totalConfirmaciones++;
+        eventosDesdeReinicio += eventosPendientes;
+        eventosPendientes = 0;
+        pendiente.clear();
+        return correcto;
+    }
+
+    /**
+     * @brief Vacía el diario después de un punto de control (ver puntoDeControl).
+     *
+     * Las secuencias siguen creciendo: los eventos que queden en el archivo
+     * si el recorte no llega al disco ya están incluidos en la instantánea y se omiten.
+     * @return true si el archivo quedó vacío.
+     */
+    bool reiniciar() {
+        if (!confirmar() || !recortar(TAMANO_CABECERA) || !sincronizar()) return false;
+        eventosDesdeReinicio = 0;
+        return true;
+    }
+
+    /// @brief Confirma lo pendiente y cierra el archivo.
+    void cerrar() {
+        if (descriptor < 0) return;
+        confirmar();
+#ifdef _WIN32
+        _close(descriptor);
+#else
+        close(descriptor);
+#endif
+        descriptor = -1;
+    }
+
+    /// @brief Secuencia del último evento registrado (0 si ninguno).
+    uint64_t ultimaSecuencia() const { return siguienteSecuencia - 1; }
+    /// @brief Eventos confirmados desde el último punto de control.
+    size_t eventosSinControl() const { return eventosDesdeReinicio; }
+    /// @brief Eventos confirmados en la sesión.
+    size_t eventosEscritos() const { return totalEventos; }
+    /// @brief Confirmaciones (fdatasync) hechas en la sesión.
+    size_t confirmaciones() const { return totalConfirmaciones; }
+    /// @brief Bytes de eventos escritos en la sesión.
+    size_t bytesEscritos() const { return totalBytes; }
+    /// @brief Ruta del diario.
+    const string& obtenerRuta() const { return ruta; }
+
+    /**
+     * @brief Lee un diario y entrega sus eventos válidos en orden.
+     * @param rutaArchivo Ruta del diario.
+     * @param desdeSecuencia Los eventos con secuencia menor o igual se omiten.
+     * @param funcion Invocada como funcion(evento) por cada evento posterior.
+     * @return Estadísticas de la lectura (un diario inexistente no tiene eventos).
+     */
+    template <typename F>
+    static EstadisticasDiario reproducir(const string& rutaArchivo, uint64_t desdeSecuencia, F funcion) {
+        EstadisticasDiario est;
+        auto inicio = chrono::steady_clock::now();
+        ArchivoMapeado archivo(rutaArchivo);
+        if (archivo.abierto() && archivo.tamano() > 0) {
+            est.bytes = recorrer(archivo.inicio(), archivo.tamano(), [&](const EventoDiario& e) {
+                est.ultimaSecuencia = e.secuencia;
+                if (e.secuencia <= desdeSecuencia) {
+                    est.omitidos++;
+                    return;
+                }
+                funcion(e);
+                est.eventos++;
+            });
+            est.bytesDescartados = archivo.tamano() - est.bytes;
+        }
+        est.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        return est;
+    }
+};
+
+/**
+ * @brief Referencias al estado que modifican los eventos del diario.
+ */
+struct EstadoSesion {
+    ABBEmpresas& arbol;
+    ColaPrioridadNoticias& cola;
+    Portafolio& usuario;
+    float& presupuesto;
+};
+
+/**
+ * @brief Aplica un evento al estado. Es el único camino por el que cambia la
+ *        sesión, tanto en vivo como al reproducir el diario.
+ *
+ * Las compras y ventas usan el precio guardado en el evento, así que no
+ * dependen de los ajustes de noticias pendientes en el lote.
+ * @param evento Evento a aplicar.
+ * @param estado Estado de la sesión.
+ * @param lote Si no es nulo, los ajustes de precio de las noticias se acumulan
+ *        aquí para aplicarlos luego con ABBEmpresas::ajustarPreciosPorNoticias.
+ * @param mostrar true para imprimir los mensajes de cada operación.
+ */
+inline void aplicarEvento(const EventoDiario& evento, EstadoSesion& estado, vector<AjusteNoticia>* lote = nullptr,
+                          bool mostrar = false) {
+    if (evento.tipo == EVENTO_COMPRA) {
+        estado.presupuesto -= evento.precio * evento.cantidad;
+        for (int i = 0; i < evento.cantidad; ++i) estado.usuario.agregarActivo(evento.ticker, mostrar);
+    } else if (evento.tipo == EVENTO_VENTA) {
+        for (int i = 0; i < evento.cantidad; ++i) estado.usuario.eliminarActivo(evento.ticker, mostrar);
+        estado.presupuesto += evento.precio * evento.cantidad;
+    } else if (evento.tipo == EVENTO_NOTICIA) {
+        estado.cola.insertar(evento.impacto, evento.titulo, evento.descripcion, evento.sector, evento.fecha,
+                             evento.esPositiva);
+        if (lote) lote->push_back({evento.sector, evento.impacto, evento.fecha});
+        else estado.arbol.ajustarPreciosPorNoticia(evento.sector, evento.impacto, evento.fecha);
+    } else if (evento.tipo == EVENTO_UMBRAL_CRISIS) {
+        if (evento.sector.empty()) estado.cola.detectorCrisis().configurarUmbralGeneral(evento.umbral);
+        else estado.cola.detectorCrisis().configurarUmbral(evento.sector, evento.umbral);
+    }
+}
+
+/**
+ * @brief Reproduce un diario sobre el estado restaurado de su instantánea.
+ *
+ * Los ajustes de todas las noticias se reúnen en un solo lote y se aplican al
+ * final en paralelo (el resultado es el mismo que aplicarlos en orden).
+ * @param ruta Ruta del diario.
+ * @param desdeSecuencia Secuencia incluida en la instantánea.
+ * @param estado Estado restaurado.
+ * @return Estadísticas de la reproducción.
+ */
+inline EstadisticasDiario reproducirDiario(const string& ruta, uint64_t desdeSecuencia, EstadoSesion& estado) {
+    auto inicio = chrono::steady_clock::now();
+    vector<AjusteNoticia> lote;
+    EstadisticasDiario est = Diario::reproducir(ruta, desdeSecuencia, [&](const EventoDiario& e) {
+        aplicarEvento(e, estado, &lote);
+    });
+    if (!lote.empty()) estado.arbol.ajustarPreciosPorNoticias(lote, hilosDisponibles());
+    est.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    return est;
+}
+
+/**
+ * @brief Punto de control: guarda una instantánea del estado y vacía el diario.
+ *
+ * La instantánea se escribe en un archivo temporal con la secuencia del último
+ * evento y luego reemplaza a la anterior con rename(), así que un corte en
+ * cualquier punto deja una instantánea completa y un diario con los eventos
+ * posteriores a ella.
+ * @param diario Diario abierto.
+ * @param rutaInstantanea Instantánea asociada al diario.
+ * @param estado Estado actual de la sesión.
+ * @return true si se completó.
+ */
+inline bool puntoDeControl(Diario& diario, const string& rutaInstantanea, EstadoSesion& estado) {
+    if (!diario.confirmar()) return false;
+    string temporal = rutaInstantanea + ".tmp";
+    if (!SnapshotMercado::guardar(temporal, estado.arbol, estado.cola, estado.usuario, estado.presupuesto,
+                                  diario.ultimaSecuencia())) {
+        cout << "No se pudo guardar el punto de control en " << temporal << ".\n";
+        remove(temporal.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    remove(rutaInstantanea.c_str());
+#endif
+    if (rename(temporal.c_str(), rutaInstantanea.c_str()) != 0) {
+        cout << "No se pudo reemplazar la instantánea " << rutaInstantanea << ".\n";
+        return false;
+    }
+#ifndef _WIN32
+    // Hacer durable el cambio de nombre antes de vaciar el diario
+    size_t barra = rutaInstantanea.find_last_of('/');
+    string carpeta = barra == string::npos ? "." : rutaInstantanea.substr(0, barra + 1);
+    int dir = open(carpeta.c_str(), O_RDONLY);
+    if (dir >= 0) {
+        fsync(dir);
+        close(dir);
+    }
+#endif
+    return diario.reiniciar();
+}
+
+/**
+ * @brief Indica si un archivo existe.
+ * @param ruta Ruta del archivo.
+ * @return true si se puede abrir para lectura.
+ */
+inline bool existeArchivo(const string& ruta) {
+    ifstream archivo(ruta, ios::binary);
+    return archivo.good();
+}
+
+#endif
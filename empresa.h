@@ -4,8 +4,18 @@
 #include <iostream>
 #include <string>
 #include <vector>
-#include <cstdlib>
-#include <ctime>
+#include <algorithm>
+#include <set>
+#include <deque>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "memoria.h"
+#include "fecha.h"
+#include "estadistica.h"
+#include "paralelo.h"
+#include "aleatorio.h"
 using namespace std;
 
 // Lista global de sectores consistente para todo el sistema
@@ -14,74 +24,655 @@ const vector<string> SECTORES_EMPRESA = {
 };
 
 /**
- * @brief Nodo para la multilista de precios históricos de una acción.
+ * @brief Bloque de capacidad fija del historial de precios, en formato columnar.
+ *
+ * Fechas y precios se guardan en arreglos separados y contiguos, de modo que
+ * recorrer los precios no salta entre nodos.
  */
-struct NodoPrecio {
-    /// Fecha del precio histórico (formato AAAA-MM-DD)
-    string fecha;
-    /// Precio de cierre en la fecha dada
-    float precioCierre;
-    /// Puntero al siguiente nodo en la lista
-    NodoPrecio* siguiente;
+struct BloqueHistorial {
+    /// Número de registros por bloque
+    static const int CAPACIDAD = 128;
+    /// Fechas de los registros
+    Fecha fechas[CAPACIDAD];
+    /// Precios de cierre de los registros
+    float precios[CAPACIDAD];
+    /// Suma acumulada de precios desde el primer registro del historial (inclusive)
+    double sumaAcumulada[CAPACIDAD];
+    /// Suma acumulada de precios al cuadrado desde el primer registro del historial (inclusive)
+    double sumaCuadradosAcumulada[CAPACIDAD];
+};
+
+/**
+ * @brief Indicadores técnicos de una acción, actualizados en O(1) con cada precio nuevo.
+ *
+ * Mantiene sobre una ventana deslizante de precios la media (SMA), la varianza
+ * (Welford con reemplazo), el mínimo y el máximo (colas monótonas), además de
+ * la media exponencial (EMA) y el RSI de Wilder sobre toda la serie.
+ * La ventana tiene capacidad fija: todos los buffers van dentro del objeto y
+ * agregar un precio nunca reserva memoria.
+ */
+class IndicadoresTecnicos {
+public:
+    /// Tamaño máximo de la ventana deslizante (potencia de dos)
+    static const int VENTANA_MAXIMA = 32;
+
+private:
+    /**
+     * @brief Cola monótona de posiciones de la ventana en un buffer circular fijo.
+     *
+     * Cada elemento es la casilla de `ultimos` donde está el precio; como la cola
+     * nunca abarca más de una ventana, la casilla identifica la posición.
+     */
+    struct ColaMonotona {
+        uint8_t casillas[VENTANA_MAXIMA];
+        uint8_t inicio = 0;
+        uint8_t tamano = 0;
+
+        bool vacia() const { return tamano == 0; }
+        uint8_t frente() const { return casillas[inicio]; }
+        uint8_t fondo() const { return casillas[(inicio + tamano - 1) & (VENTANA_MAXIMA - 1)]; }
+        void agregarAlFondo(uint8_t c) { casillas[(inicio + tamano++) & (VENTANA_MAXIMA - 1)] = c; }
+        void quitarDelFondo() { --tamano; }
+        void quitarDelFrente() {
+            inicio = (inicio + 1) & (VENTANA_MAXIMA - 1);
+            --tamano;
+        }
+    };
+
+    /// Tamaño de la ventana deslizante (SMA, varianza, mínimo y máximo)
+    int ventana;
+    /// Periodo del RSI
+    int periodoRSI;
+    /// Factor de suavizado de la EMA (2 / (ventana + 1))
+    double alfa;
+    /// Últimos precios de la ventana (buffer circular; se usan las primeras `ventana` casillas)
+    float ultimos[VENTANA_MAXIMA];
+    /// Número total de precios recibidos
+    size_t total;
+    /// Media de la ventana
+    double mediaVentana;
+    /// Suma de cuadrados de las desviaciones de la ventana (Welford)
+    double m2;
+    /// Media exponencial
+    double emaActual;
+    /// Ganancia media del RSI
+    double gananciaMedia;
+    /// Pérdida media del RSI
+    double perdidaMedia;
+    /// Precio anterior (para las variaciones del RSI)
+    float anterior;
+    /// Candidatos a mínimo de la ventana, con precios crecientes
+    ColaMonotona colaMin;
+    /// Candidatos a máximo de la ventana, con precios decrecientes
+    ColaMonotona colaMax;
+
+    /// @brief Agrega la casilla `c` a las colas monótonas (su precio ya está en `ultimos`).
+    void encolarExtremos(uint8_t c) {
+        float precio = ultimos[c];
+        while (!colaMin.vacia() && ultimos[colaMin.fondo()] >= precio) colaMin.quitarDelFondo();
+        colaMin.agregarAlFondo(c);
+        while (!colaMax.vacia() && ultimos[colaMax.fondo()] <= precio) colaMax.quitarDelFondo();
+        colaMax.agregarAlFondo(c);
+    }
+
+    /**
+     * @brief Reconstruye las colas de mínimo y máximo a partir de los precios de la ventana.
+     *
+     * Las colas son función de `ultimos` y `total`, así que no hace falta guardarlas.
+     */
+    void reconstruirExtremos() {
+        colaMin = ColaMonotona();
+        colaMax = ColaMonotona();
+        size_t n = min(total, (size_t)ventana);
+        for (size_t p = total - n; p < total; ++p) encolarExtremos((uint8_t)(p % ventana));
+    }
+
+public:
+    /**
+     * @brief Constructor de IndicadoresTecnicos.
+     * @param v Tamaño de la ventana deslizante (y periodo de la EMA), entre 1 y VENTANA_MAXIMA.
+     * @param rsi Periodo del RSI.
+     */
+    IndicadoresTecnicos(int v = 5, int rsi = 14)
+        : ventana(v < 1 ? 1 : (v > VENTANA_MAXIMA ? VENTANA_MAXIMA : v)), periodoRSI(rsi),
+          alfa(2.0 / (ventana + 1)), ultimos(), total(0), mediaVentana(0), m2(0), emaActual(0), gananciaMedia(0),
+          perdidaMedia(0), anterior(0) {}
 
     /**
-     * @brief Constructor de NodoPrecio.
-     * @param f Fecha del precio.
-     * @param p Precio de cierre.
+     * @brief Incorpora un precio nuevo a todos los indicadores.
+     * @param precio Precio de cierre.
      */
-    NodoPrecio(string f, float p) : fecha(f), precioCierre(p), siguiente(nullptr) {}
+    void agregar(float precio) {
+        size_t pos = total % ventana;
+        if (total < (size_t)ventana) {
+            // La ventana aún no está llena: paso normal de Welford
+            double n = (double)(total + 1);
+            double delta = precio - mediaVentana;
+            mediaVentana += delta / n;
+            m2 += delta * (precio - mediaVentana);
+        } else {
+            // Ventana llena: el precio nuevo reemplaza al más antiguo
+            double sale = ultimos[pos];
+            double mediaNueva = mediaVentana + (precio - sale) / ventana;
+            m2 += (precio - sale) * (precio - mediaNueva + sale - mediaVentana);
+            if (m2 < 0) m2 = 0;
+            mediaVentana = mediaNueva;
+            // El precio que sale deja de ser candidato antes de que se pise su casilla
+            if (colaMin.frente() == pos) colaMin.quitarDelFrente();
+            if (colaMax.frente() == pos) colaMax.quitarDelFrente();
+        }
+        ultimos[pos] = precio;
+        encolarExtremos((uint8_t)pos);
+
+        // EMA sembrada con el primer precio
+        emaActual = (total == 0) ? precio : emaActual + alfa * (precio - emaActual);
+
+        // RSI de Wilder: promedio simple de las primeras variaciones y luego suavizado
+        if (total > 0) {
+            double cambio = (double)precio - anterior;
+            double ganancia = cambio > 0 ? cambio : 0;
+            double perdida = cambio < 0 ? -cambio : 0;
+            if (total <= (size_t)periodoRSI) {
+                gananciaMedia += (ganancia - gananciaMedia) / total;
+                perdidaMedia += (perdida - perdidaMedia) / total;
+            } else {
+                gananciaMedia = (gananciaMedia * (periodoRSI - 1) + ganancia) / periodoRSI;
+                perdidaMedia = (perdidaMedia * (periodoRSI - 1) + perdida) / periodoRSI;
+            }
+        }
+        anterior = precio;
+        total++;
+    }
+
+    /**
+     * @brief Escribe el estado interno en un archivo binario (ver SnapshotMercado).
+     *
+     * Las colas de mínimo y máximo no se guardan: se reconstruyen al cargar.
+     */
+    void guardar(EscritorBinario& salida) const {
+        salida.valor<int32_t>(ventana);
+        salida.valor<int32_t>(periodoRSI);
+        salida.valor<uint64_t>(total);
+        salida.valor(mediaVentana);
+        salida.valor(m2);
+        salida.valor(emaActual);
+        salida.valor(gananciaMedia);
+        salida.valor(perdidaMedia);
+        salida.valor(anterior);
+        salida.bytes(ultimos, ventana * sizeof(float));
+    }
+
+    /**
+     * @brief Lee el estado escrito por guardar().
+     * @param entrada Lector; se invalida si la ventana o el periodo no son válidos.
+     */
+    void cargar(LectorBinario& entrada) {
+        int32_t v = entrada.valor<int32_t>();
+        int32_t rsi = entrada.valor<int32_t>();
+        if (v <= 0 || v > VENTANA_MAXIMA || rsi <= 0) {
+            entrada.invalidar();
+            return;
+        }
+        *this = IndicadoresTecnicos(v, rsi);
+        total = entrada.valor<uint64_t>();
+        mediaVentana = entrada.valor<double>();
+        m2 = entrada.valor<double>();
+        emaActual = entrada.valor<double>();
+        gananciaMedia = entrada.valor<double>();
+        perdidaMedia = entrada.valor<double>();
+        anterior = entrada.valor<float>();
+        for (int k = 0; k < ventana; ++k) ultimos[k] = entrada.valor<float>();
+        reconstruirExtremos();
+    }
+
+    /// @brief Número de precios recibidos.
+    size_t cantidad() const { return total; }
+    /// @brief Tamaño de la ventana deslizante.
+    int tamanoVentana() const { return ventana; }
+    /// @brief Media simple de la ventana (0 sin datos).
+    float media() const { return (float)mediaVentana; }
+    /// @brief Varianza poblacional de la ventana (0 sin datos).
+    float varianza() const {
+        size_t n = min(total, (size_t)ventana);
+        return n > 0 ? (float)(m2 / n) : 0;
+    }
+    /// @brief Desviación estándar poblacional de la ventana.
+    float desviacion() const { return sqrt(varianza()); }
+    /// @brief Precio mínimo de la ventana (0 sin datos).
+    float minimo() const { return colaMin.vacia() ? 0 : ultimos[colaMin.frente()]; }
+    /// @brief Precio máximo de la ventana (0 sin datos).
+    float maximo() const { return colaMax.vacia() ? 0 : ultimos[colaMax.frente()]; }
+    /// @brief Media exponencial (0 sin datos).
+    float ema() const { return (float)emaActual; }
+    /// @brief Índice de fuerza relativa entre 0 y 100 (50 si no hay variaciones).
+    float rsi() const {
+        if (gananciaMedia == 0 && perdidaMedia == 0) return 50;
+        if (perdidaMedia == 0) return 100;
+        return (float)(100.0 - 100.0 / (1.0 + gananciaMedia / perdidaMedia));
+    }
 };
 
 /**
- * @brief Multilista para historial de precios de una acción.
+ * @brief Historial de precios de una acción almacenado por columnas.
+ *
+ * Los registros se agregan al final (índice 0 = el más antiguo) en bloques de
+ * tamaño fijo: crecer no copia datos y el acceso por índice es O(1).
+ * Cada registro guarda además las sumas acumuladas de precios y de sus
+ * cuadrados, así que la media y la varianza de cualquier ventana son O(1).
+ * Un índice por fecha, puesto al día con cada registro nuevo, resuelve el
+ * precio de una fecha o el anterior a ella en O(log n) sin modificar el
+ * historial, así que las consultas concurrentes son de solo lectura.
  */
-class MultilistaPrecio {
+class HistorialPrecios {
+private:
+    /// Bloques de registros, en orden cronológico de inserción
+    vector<BloqueHistorial*> bloques;
+    /// Número total de registros
+    size_t cantidad;
+    /// Indicadores técnicos actualizados con cada registro
+    IndicadoresTecnicos indicadoresActuales;
+    /// true si los registros están en orden cronológico (el índice por fecha es la identidad)
+    bool cronologico;
+    /// Registros ordenados por (fecha, posición); vacío mientras el historial sea cronológico
+    vector<uint32_t> porFecha;
+
+    /**
+     * @brief Incorpora el último registro agregado al índice por fecha.
+     *
+     * Mientras los registros lleguen en orden cronológico basta con comparar la
+     * fecha con la anterior (O(1)). Desde el primer registro fuera de orden se
+     * mantiene una permutación ordenada y cada registro nuevo se inserta en su
+     * lugar (O(n) en el peor caso, O(1) si llega en orden).
+     */
+    void indexarUltimo() {
+        size_t i = cantidad - 1;
+        if (cronologico) {
+            if (i == 0 || !(fecha(i) < fecha(i - 1))) return;
+            cronologico = false;
+            porFecha.resize(i);
+            for (size_t k = 0; k < i; ++k) porFecha[k] = k;
+        }
+        // A igual fecha queda después de los anteriores (orden de inserción)
+        Fecha f = fecha(i);
+        auto lugar = upper_bound(porFecha.begin(), porFecha.end(), f,
+                                 [this](Fecha buscada, uint32_t r) { return buscada < fecha(r); });
+        porFecha.insert(lugar, (uint32_t)i);
+    }
+
+    /// @brief Registro que ocupa el lugar k en orden de fecha.
+    size_t registroEnOrden(size_t k) const { return cronologico ? k : porFecha[k]; }
+
+    /// @brief Primer lugar en orden de fecha con fecha >= f.
+    size_t primeroDesde(Fecha f) const {
+        size_t bajo = 0, alto = cantidad;
+        while (bajo < alto) {
+            size_t medio = bajo + (alto - bajo) / 2;
+            if (fecha(registroEnOrden(medio)) < f) bajo = medio + 1;
+            else alto = medio;
+        }
+        return bajo;
+    }
+
+    /**
+     * @brief Reconstruye el índice por fecha desde cero.
+     *
+     * Solo hace falta tras adoptar bloques ya escritos (ver cargarEstado).
+     * O(n) si el historial es cronológico, O(n log n) si no.
+     */
+    void reconstruirIndiceFechas() {
+        cronologico = true;
+        porFecha.clear();
+        for (size_t i = 1; i < cantidad && cronologico; ++i)
+            if (fecha(i) < fecha(i - 1)) cronologico = false;
+        if (cronologico) return;
+        porFecha.resize(cantidad);
+        for (size_t i = 0; i < cantidad; ++i) porFecha[i] = i;
+        stable_sort(porFecha.begin(), porFecha.end(), [this](uint32_t a, uint32_t b) { return fecha(a) < fecha(b); });
+    }
+
 public:
-    /// Puntero al primer nodo de la lista de precios
-    NodoPrecio* cabeza;
+    /// Pool del que se toman los bloques (nullptr = new/delete individuales)
+    PoolNodos<BloqueHistorial>* pool;
+
+    /**
+     * @brief Constructor de HistorialPrecios.
+     */
+    HistorialPrecios() : cantidad(0), cronologico(true), pool(nullptr) {}
+
+    HistorialPrecios(const HistorialPrecios&) = delete;
+    HistorialPrecios& operator=(const HistorialPrecios&) = delete;
 
     /**
-     * @brief Constructor de MultilistaPrecio.
+     * @brief Destructor. Si los bloques vienen de un pool, es el pool quien los libera.
      */
-    MultilistaPrecio() : cabeza(nullptr) {}
+    ~HistorialPrecios() {
+        if (pool) return;
+        for (BloqueHistorial* b : bloques) delete b;
+    }
 
     /**
-     * @brief Agrega un precio al historial (al inicio de la lista).
+     * @brief Agrega un precio al final del historial.
      * @param fecha Fecha del precio.
      * @param precio Precio de cierre.
      */
-    void agregarPrecio(const string& fecha, float precio) {
-        NodoPrecio* nuevo = new NodoPrecio(fecha, precio);
-        nuevo->siguiente = cabeza;
-        cabeza = nuevo;
+    void agregarPrecio(Fecha fecha, float precio) { agregarPrecio(fecha, precio, pool); }
+
+    /**
+     * @brief Agrega un precio al final del historial tomando el bloque nuevo, si hace falta, de otro pool.
+     *
+     * Sirve para que varios hilos agreguen a la vez a historiales distintos, cada
+     * uno con su propio pool (PoolNodos no es seguro entre hilos), sin cambiar el
+     * pool del historial. `origen` debe vivir tanto como `pool`; si el historial
+     * no usa pool se ignora.
+     * @param fecha Fecha del precio.
+     * @param precio Precio de cierre.
+     * @param origen Pool del que tomar el bloque.
+     */
+    void agregarPrecio(Fecha fecha, float precio, PoolNodos<BloqueHistorial>* origen) {
+        size_t pos = cantidad % BloqueHistorial::CAPACIDAD;
+        if (pos == 0) bloques.push_back(pool ? (origen ? origen : pool)->crear() : new BloqueHistorial());
+        BloqueHistorial* bloque = bloques.back();
+        bloque->fechas[pos] = fecha;
+        bloque->precios[pos] = precio;
+        bloque->sumaAcumulada[pos] = sumaHasta(cantidad) + precio;
+        bloque->sumaCuadradosAcumulada[pos] = sumaCuadradosHasta(cantidad) + (double)precio * precio;
+        cantidad++;
+        indexarUltimo();
+        indicadoresActuales.agregar(precio);
+    }
+
+    /**
+     * @brief Indicadores técnicos precalculados sobre los últimos precios.
+     * @return Referencia a los indicadores (ventana de 5 registros).
+     */
+    const IndicadoresTecnicos& indicadores() const { return indicadoresActuales; }
+
+    /// @brief Número de bloques que ocupan los registros.
+    size_t numBloques() const { return bloques.size(); }
+
+    /**
+     * @brief Escribe los bloques tal como están en memoria (ver SnapshotMercado).
+     * @param salida Escritor binario.
+     */
+    void guardarBloques(EscritorBinario& salida) const {
+        for (const BloqueHistorial* b : bloques) salida.valor(*b);
+    }
+
+    /**
+     * @brief Escribe el número de registros y los indicadores técnicos.
+     * @param salida Escritor binario.
+     */
+    void guardarEstado(EscritorBinario& salida) const {
+        salida.valor<uint64_t>(cantidad);
+        indicadoresActuales.guardar(salida);
+    }
+
+    /**
+     * @brief Lee lo escrito por guardarEstado() y adopta sus bloques ya escritos, sin copiarlos.
+     *
+     * El historial debe estar vacío. Los bloques adoptados no son del pool ni se
+     * liberan aquí: quien los provee debe mantenerlos vivos mientras exista el historial.
+     * @param entrada Lector; se invalida si no quedan bloques suficientes.
+     * @param siguiente Primer bloque disponible; avanza tras los bloques adoptados.
+     * @param fin Fin de los bloques disponibles.
+     */
+    void cargarEstado(LectorBinario& entrada, BloqueHistorial*& siguiente, BloqueHistorial* fin) {
+        uint64_t registros = entrada.valor<uint64_t>();
+        indicadoresActuales.cargar(entrada);
+        uint64_t necesarios = (registros + BloqueHistorial::CAPACIDAD - 1) / BloqueHistorial::CAPACIDAD;
+        if (!entrada.correcto() || !bloques.empty() || necesarios > (uint64_t)(fin - siguiente)) {
+            entrada.invalidar();
+            return;
+        }
+        bloques.resize(necesarios);
+        for (BloqueHistorial*& b : bloques) b = siguiente++;
+        cantidad = registros;
+        reconstruirIndiceFechas();
+    }
+
+    /**
+     * @brief Suma de los primeros n precios del historial en O(1).
+     * @param n Número de registros (desde el más antiguo).
+     * @return Suma de los precios de los registros [0, n).
+     */
+    double sumaHasta(size_t n) const {
+        if (n == 0) return 0;
+        return bloques[(n - 1) / BloqueHistorial::CAPACIDAD]->sumaAcumulada[(n - 1) % BloqueHistorial::CAPACIDAD];
+    }
+
+    /**
+     * @brief Suma de los cuadrados de los primeros n precios del historial en O(1).
+     * @param n Número de registros (desde el más antiguo).
+     * @return Suma de los cuadrados de los precios de los registros [0, n).
+     */
+    double sumaCuadradosHasta(size_t n) const {
+        if (n == 0) return 0;
+        return bloques[(n - 1) / BloqueHistorial::CAPACIDAD]->sumaCuadradosAcumulada[(n - 1) % BloqueHistorial::CAPACIDAD];
+    }
+
+    /**
+     * @brief Promedio de los precios de los registros [desde, hasta] en O(1).
+     * @param desde Índice inicial (inclusive).
+     * @param hasta Índice final (inclusive, se recorta al último registro).
+     * @return Promedio de la ventana, o 0 si está vacía.
+     */
+    float promedioRango(size_t desde, size_t hasta) const {
+        if (cantidad == 0 || desde > hasta || desde >= cantidad) return 0;
+        size_t fin = hasta >= cantidad ? cantidad : hasta + 1;
+        return (float)((sumaHasta(fin) - sumaHasta(desde)) / (fin - desde));
+    }
+
+    /**
+     * @brief Varianza poblacional de los precios de los registros [desde, hasta] en O(1).
+     * @param desde Índice inicial (inclusive).
+     * @param hasta Índice final (inclusive, se recorta al último registro).
+     * @return Varianza de la ventana, o 0 si está vacía.
+     */
+    float varianzaRango(size_t desde, size_t hasta) const {
+        if (cantidad == 0 || desde > hasta || desde >= cantidad) return 0;
+        size_t fin = hasta >= cantidad ? cantidad : hasta + 1;
+        double n = (double)(fin - desde);
+        double media = (sumaHasta(fin) - sumaHasta(desde)) / n;
+        double varianza = (sumaCuadradosHasta(fin) - sumaCuadradosHasta(desde)) / n - media * media;
+        return varianza > 0 ? (float)varianza : 0; // el redondeo puede dar un negativo mínimo
+    }
+
+    /**
+     * @brief Varianza poblacional de los últimos 'dias' precios en O(1).
+     * @param dias Número de días a considerar.
+     * @return Varianza de la ventana, o 0 si no hay registros.
+     */
+    float varianzaMovil(int dias) const {
+        size_t n = (dias > 0) ? min((size_t)dias, cantidad) : 0;
+        return (n > 0) ? varianzaRango(cantidad - n, cantidad - 1) : 0;
+    }
+
+    /**
+     * @brief Serie completa de promedios móviles en una sola pasada O(n).
+     * @param dias Tamaño de la ventana.
+     * @return Vector donde la posición i es el promedio de los registros (i - dias, i]
+     *         (o de los i + 1 primeros si aún no hay 'dias' registros).
+     */
+    vector<float> serieMediaMovil(int dias) const {
+        vector<float> serie;
+        if (dias <= 0) return serie;
+        serie.reserve(cantidad);
+        for (size_t i = 0; i < cantidad; ++i) {
+            size_t desde = (i + 1 > (size_t)dias) ? i + 1 - dias : 0;
+            serie.push_back((float)((sumaHasta(i + 1) - sumaHasta(desde)) / (i + 1 - desde)));
+        }
+        return serie;
+    }
+
+    /// @brief Número de registros del historial.
+    size_t size() const { return cantidad; }
+
+    /// @brief Indica si el historial no tiene registros.
+    bool vacio() const { return cantidad == 0; }
+
+    /// @brief Fecha más reciente del historial (Fecha() si está vacío). O(1).
+    Fecha ultimaFecha() const { return cantidad == 0 ? Fecha() : fecha(registroEnOrden(cantidad - 1)); }
+
+    /**
+     * @brief Precio del registro i (0 = el más antiguo).
+     * @param i Índice del registro.
+     * @return Precio de cierre.
+     */
+    float precio(size_t i) const {
+        return bloques[i / BloqueHistorial::CAPACIDAD]->precios[i % BloqueHistorial::CAPACIDAD];
+    }
+
+    /**
+     * @brief Fecha del registro i (0 = el más antiguo).
+     * @param i Índice del registro.
+     * @return Fecha del registro.
+     */
+    Fecha fecha(size_t i) const {
+        return bloques[i / BloqueHistorial::CAPACIDAD]->fechas[i % BloqueHistorial::CAPACIDAD];
     }
 
     /**
-     * @brief Calcula el promedio móvil de los últimos 'dias' precios.
+     * @brief Precio del último registro agregado.
+     * @return Precio de cierre más reciente (0 si está vacío).
+     */
+    float ultimoPrecio() const {
+        return cantidad > 0 ? precio(cantidad - 1) : 0;
+    }
+
+    /**
+     * @brief Calcula el promedio móvil de los últimos 'dias' precios en O(1).
      * @param dias Número de días a considerar.
      * @return Promedio móvil calculado.
      */
-    float promedioMovil(int dias) {
-        float suma = 0;
-        int cont = 0;
-        NodoPrecio* actual = cabeza;
-        while (actual && cont < dias) {
-            suma += actual->precioCierre;
-            actual = actual->siguiente;
-            cont++;
+    float promedioMovil(int dias) const {
+        size_t n = (dias > 0) ? min((size_t)dias, cantidad) : 0;
+        return (n > 0) ? promedioRango(cantidad - n, cantidad - 1) : 0;
+    }
+
+    /**
+     * @brief Copia los precios de los registros [desde, hasta) a un arreglo contiguo.
+     * @param desde Índice inicial (inclusive).
+     * @param hasta Índice final (exclusive, se recorta al último registro).
+     * @param salida Arreglo con espacio para hasta - desde precios.
+     * @return Número de precios copiados.
+     */
+    size_t copiarPrecios(size_t desde, size_t hasta, float* salida) const {
+        hasta = min(hasta, cantidad);
+        size_t copiados = 0;
+        for (size_t i = desde; i < hasta;) {
+            size_t b = i / BloqueHistorial::CAPACIDAD, pos = i % BloqueHistorial::CAPACIDAD;
+            size_t trozo = min(hasta - i, BloqueHistorial::CAPACIDAD - pos);
+            copy(bloques[b]->precios + pos, bloques[b]->precios + pos + trozo, salida + copiados);
+            copiados += trozo;
+            i += trozo;
         }
-        return (cont > 0) ? suma / cont : 0;
+        return copiados;
     }
 
     /**
-     * @brief Imprime el historial de precios por consola.
+     * @brief Mínimo y máximo de los precios de los registros [desde, hasta] con núcleos vectorizados.
+     * @param desde Índice inicial (inclusive).
+     * @param hasta Índice final (inclusive, se recorta al último registro).
+     * @param minimo Precio mínimo (salida; 0 si la ventana está vacía).
+     * @param maximo Precio máximo (salida; 0 si la ventana está vacía).
      */
-    void imprimir() {
-        NodoPrecio* actual = cabeza;
-        while (actual) {
-            cout << actual->fecha << ": " << actual->precioCierre << "  ";
-            actual = actual->siguiente;
+    void minMaxRango(size_t desde, size_t hasta, float& minimo, float& maximo) const {
+        minimo = maximo = 0;
+        size_t fin = hasta >= cantidad ? cantidad : hasta + 1;
+        bool primero = true;
+        // Cada bloque es contiguo: se aplica el núcleo por tramos
+        for (size_t i = desde; i < fin;) {
+            size_t b = i / BloqueHistorial::CAPACIDAD, pos = i % BloqueHistorial::CAPACIDAD;
+            size_t trozo = min(fin - i, BloqueHistorial::CAPACIDAD - pos);
+            float mn, mx;
+            minMaxSerie(bloques[b]->precios + pos, trozo, mn, mx);
+            if (primero || mn < minimo) minimo = mn;
+            if (primero || mx > maximo) maximo = mx;
+            primero = false;
+            i += trozo;
         }
+    }
+
+    /**
+     * @brief Retornos logarítmicos de todo el historial, en orden de inserción.
+     * @return Vector con size() - 1 retornos (vacío si hay menos de dos registros).
+     */
+    vector<float> retornosLogaritmicos() const {
+        vector<float> retornos;
+        if (cantidad < 2) return retornos;
+        vector<float> precios(cantidad);
+        copiarPrecios(0, cantidad, precios.data());
+        retornos.resize(cantidad - 1);
+        logRetornosSerie(precios.data(), cantidad, retornos.data());
+        return retornos;
+    }
+
+    /**
+     * @brief Precio registrado en una fecha (el primero agregado si hay varios). O(log n).
+     * @param dia Fecha buscada.
+     * @param salida Precio encontrado.
+     * @return false si no hay registros con esa fecha.
+     */
+    bool precioEnFecha(Fecha dia, float& salida) const {
+        size_t k = primeroDesde(dia);
+        if (k == cantidad || !(fecha(registroEnOrden(k)) == dia)) return false;
+        salida = precio(registroEnOrden(k));
+        return true;
+    }
+
+    /**
+     * @brief Último precio anterior a una fecha: el de la fecha previa más reciente
+     *        (el último agregado si hay varios). O(log n).
+     * @param dia Fecha de referencia (excluida).
+     * @param salida Precio encontrado.
+     * @param fechaAnterior Si no es nullptr, recibe la fecha de ese precio.
+     * @return false si no hay registros anteriores a la fecha.
+     */
+    bool precioAntesDe(Fecha dia, float& salida, Fecha* fechaAnterior = nullptr) const {
+        size_t k = primeroDesde(dia);
+        if (k == 0) return false;
+        size_t i = registroEnOrden(k - 1);
+        salida = precio(i);
+        if (fechaAnterior) *fechaAnterior = fecha(i);
+        return true;
+    }
+
+    /**
+     * @brief Copia el cierre de cada fecha en orden de fecha: si una fecha tiene
+     *        varios registros, queda el último agregado. O(n).
+     * @param fechas Fechas ordenadas y sin repetir (salida).
+     * @param precios Cierre de cada fecha (salida).
+     */
+    void cierresEnOrdenDeFecha(vector<Fecha>& fechas, vector<float>& precios) const {
+        fechas.resize(cantidad);
+        precios.resize(cantidad);
+        if (cronologico) {
+            copiarPrecios(0, cantidad, precios.data());
+            for (size_t i = 0; i < cantidad; ++i) fechas[i] = fecha(i);
+        } else {
+            for (size_t k = 0; k < cantidad; ++k) {
+                fechas[k] = fecha(porFecha[k]);
+                precios[k] = precio(porFecha[k]);
+            }
+        }
+        // A igual fecha los registros están en orden de inserción: cada uno pisa al anterior
+        size_t n = 0;
+        for (size_t k = 0; k < cantidad; ++k) {
+            if (n > 0 && fechas[n - 1] == fechas[k]) n--;
+            fechas[n] = fechas[k];
+            precios[n] = precios[k];
+            n++;
+        }
+        fechas.resize(n);
+        precios.resize(n);
+    }
+
+    /**
+     * @brief Imprime el historial de precios por consola (del más reciente al más antiguo).
+     */
+    void imprimir() const {
+        for (size_t i = cantidad; i > 0; --i)
+            cout << fecha(i - 1) << ": " << precio(i - 1) << "  ";
         cout << endl;
     }
 };
@@ -96,14 +687,18 @@ struct Empresa {
     string nombre;
     /// Sector al que pertenece la empresa
     string sector;
-    /// Precio actual de la acción
+    /// Identificador numérico del sector (posición en SECTORES_EMPRESA, o posterior si es un sector nuevo)
+    int sectorId;
+    /// Precio actual de la acción (solo ABBEmpresas debe modificarlo, ya que lo indexa)
     float precioActual;
     /// Historial de precios de la acción
-    MultilistaPrecio historialPrecios;
+    HistorialPrecios historialPrecios;
     /// Puntero al hijo izquierdo en el ABB
     Empresa* izquierda;
     /// Puntero al hijo derecho en el ABB
     Empresa* derecha;
+    /// Altura del subárbol con raíz en este nodo (hoja = 1), usada para el balanceo AVL
+    int altura;
 
     /**
      * @brief Constructor de Empresa.
@@ -113,20 +708,469 @@ struct Empresa {
      * @param p Precio actual.
      */
     Empresa(string t, string n, string s, float p)
-        : ticker(t), nombre(n), sector(s), precioActual(p),
-          izquierda(nullptr), derecha(nullptr) {}
+        : ticker(t), nombre(n), sector(s), sectorId(-1), precioActual(p),
+          izquierda(nullptr), derecha(nullptr), altura(1) {}
+};
+
+/**
+ * @brief Comparador del índice por precio: ordena por (precio, ticker).
+ *
+ * Un puntero nulo en la segunda componente actúa como cota inferior para el
+ * precio dado, lo que permite buscar con lower_bound({precio, nullptr}).
+ */
+struct ComparaPrecio {
+    bool operator()(const pair<float, Empresa*>& a, const pair<float, Empresa*>& b) const {
+        if (a.first != b.first) return a.first < b.first;
+        if (!a.second) return b.second != nullptr;
+        if (!b.second) return false;
+        return a.second->ticker < b.second->ticker;
+    }
+};
+
+/**
+ * @brief Agregados de precio de un sector, mantenidos incrementalmente.
+ */
+struct AgregadoSector {
+    /// Suma de los precios actuales del sector (en double para no acumular error)
+    double suma = 0;
+    /// Número de empresas del sector
+    int cantidad = 0;
+    /// Precios actuales del sector ordenados, para leer mínimo y máximo en O(1)
+    multiset<float> precios;
+
+    /// @brief Promedio de los precios actuales (0 si el sector está vacío).
+    float promedio() const { return cantidad > 0 ? (float)(suma / cantidad) : 0; }
+    /// @brief Precio mínimo del sector (0 si el sector está vacío).
+    float minimo() const { return precios.empty() ? 0 : *precios.begin(); }
+    /// @brief Precio máximo del sector (0 si el sector está vacío).
+    float maximo() const { return precios.empty() ? 0 : *precios.rbegin(); }
+
+    /// @brief Registra una empresa con el precio dado.
+    void agregar(float precio) {
+        suma += precio;
+        cantidad++;
+        precios.insert(precio);
+    }
+
+    /// @brief Reemplaza el precio de una empresa ya registrada.
+    void actualizar(float anterior, float nuevo) {
+        suma += (double)nuevo - anterior;
+        precios.erase(precios.find(anterior));
+        precios.insert(nuevo);
+    }
+};
+
+/**
+ * @brief Noticia reducida a lo necesario para ajustar precios (ver ajustarPreciosPorNoticias).
+ */
+struct AjusteNoticia {
+    /// Sector afectado
+    string sector;
+    /// Impacto de la noticia (1-10)
+    int impacto;
+    /// Fecha con la que se registra el nuevo precio
+    Fecha fecha;
+};
+
+/**
+ * @brief Datos de una empresa para la carga masiva del árbol.
+ */
+struct DatosEmpresa {
+    /// Ticker de la empresa
+    string ticker;
+    /// Nombre de la empresa
+    string nombre;
+    /// Sector al que pertenece la empresa
+    string sector;
+    /// Precio actual de la acción
+    float precio;
+};
+
+/**
+ * @brief Serie de precios de cierre de un ticker, leída de una fuente externa (ver cargarHistoriales).
+ */
+struct SeriePrecios {
+    /// Ticker de la empresa
+    string ticker;
+    /// Sector (vacío si la fuente no lo indica)
+    string sector;
+    /// Fechas de los precios, en el mismo orden que precios
+    vector<Fecha> fechas;
+    /// Precios de cierre
+    vector<float> precios;
+};
+
+/**
+ * @brief Deriva y volatilidad anuales de los precios de un sector (movimiento browniano geométrico).
+ */
+struct ParametrosSector {
+    /// Rendimiento medio anual (0.08 = 8%)
+    double deriva;
+    /// Desviación estándar anual de los rendimientos (0.25 = 25%)
+    double volatilidad;
+};
+
+/// @brief Parámetros por defecto de cada sector, en el orden de SECTORES_EMPRESA.
+const vector<ParametrosSector> PARAMETROS_SECTORES = {
+    {0.12, 0.35}, {0.07, 0.22}, {0.08, 0.25}, {0.06, 0.18},
+    {0.05, 0.30}, {0.07, 0.20}, {0.04, 0.17}, {0.06, 0.26}
 };
 
 /**
- * @brief Árbol binario de búsqueda (ABB) para gestionar empresas.
+ * @brief Configuración de un mercado sintético de gran tamaño (ver ABBEmpresas(const ConfiguracionMercado&)).
+ */
+struct ConfiguracionMercado {
+    /// Número de empresas (tickers) a generar
+    size_t empresas;
+    /// Número de días hábiles de historial por empresa
+    int dias;
+    /// Primer día del historial (si no es hábil se usa el lunes siguiente)
+    Fecha inicio;
+    /// Semilla del mercado; la misma semilla reproduce el mismo mercado
+    uint64_t semilla;
+    /// Rango del precio inicial de cada empresa
+    float precioMinimo, precioMaximo;
+    /// Deriva y volatilidad por sector, en el orden de SECTORES_EMPRESA
+    vector<ParametrosSector> sectores;
+
+    /// @brief Configuración por defecto: 50 empresas y 26 días hábiles desde el 2025-05-01.
+    ConfiguracionMercado()
+        : empresas(50), dias(26), inicio(Fecha::desdeCivil(2025, 5, 1)), semilla(1),
+          precioMinimo(50), precioMaximo(500), sectores(PARAMETROS_SECTORES) {}
+};
+
+/**
+ * @brief Iterador inorden no recursivo sobre el árbol de empresas.
+ *
+ * Guarda el camino pendiente en una pila de tamaño fijo (la altura de un AVL
+ * está acotada por 1.44·log2(n)), así que recorrer no reserva memoria. Puede
+ * limitarse a un rango de tickers [desde, hasta].
+ */
+class IteradorEmpresas {
+private:
+    /// Altura máxima soportada; un AVL de 64 niveles tiene más de 10^13 nodos
+    static const int MAX_ALTURA = 64;
+    /// Nodos pendientes de visitar; el tope es el nodo actual
+    Empresa* pila[MAX_ALTURA];
+    /// Número de nodos en la pila (0 = fin del recorrido)
+    int tope;
+    /// Cota superior del rango (inclusive)
+    string hasta;
+    /// Indica si el recorrido tiene cota superior
+    bool conHasta;
+
+    /**
+     * @brief Apila el camino de un nodo hacia su descendiente más a la izquierda.
+     * @param nodo Nodo inicial.
+     */
+    void apilarIzquierda(Empresa* nodo) {
+        while (nodo) {
+            pila[tope++] = nodo;
+            nodo = nodo->izquierda;
+        }
+    }
+
+    /// @brief Termina el recorrido si el nodo actual se sale del rango.
+    void verificarCota() {
+        if (conHasta && tope > 0 && pila[tope - 1]->ticker > hasta) tope = 0;
+    }
+
+public:
+    /// @brief Construye el iterador de fin.
+    IteradorEmpresas() : tope(0), conHasta(false) {}
+
+    /**
+     * @brief Construye un iterador posicionado en la primera empresa del rango.
+     * @param raiz Raíz del árbol.
+     * @param desde Cota inferior (inclusive), o nullptr para empezar desde el inicio.
+     * @param hastaTicker Cota superior (inclusive), o nullptr para llegar hasta el final.
+     */
+    IteradorEmpresas(Empresa* raiz, const string* desde = nullptr, const string* hastaTicker = nullptr)
+        : tope(0), conHasta(hastaTicker != nullptr) {
+        if (hastaTicker) hasta = *hastaTicker;
+        if (!desde) {
+            apilarIzquierda(raiz);
+        } else {
+            // Solo se apilan los ancestros con ticker >= desde (aún pendientes de visitar)
+            Empresa* nodo = raiz;
+            while (nodo) {
+                if (nodo->ticker < *desde) {
+                    nodo = nodo->derecha;
+                } else {
+                    pila[tope++] = nodo;
+                    nodo = nodo->izquierda;
+                }
+            }
+        }
+        verificarCota();
+    }
+
+    /// @brief Empresa actual.
+    Empresa* operator*() const { return pila[tope - 1]; }
+
+    /// @brief Avanza a la siguiente empresa en orden de ticker.
+    IteradorEmpresas& operator++() {
+        Empresa* actual = pila[--tope];
+        apilarIzquierda(actual->derecha);
+        verificarCota();
+        return *this;
+    }
+
+    /// @brief Compara iteradores (dos iteradores terminados son iguales).
+    bool operator!=(const IteradorEmpresas& otro) const {
+        if (tope == 0 || otro.tope == 0) return tope != otro.tope;
+        return pila[tope - 1] != otro.pila[otro.tope - 1];
+    }
+};
+
+/**
+ * @brief Rango de empresas recorrible con for (por ticker, límites inclusivos).
+ */
+class RangoEmpresas {
+private:
+    /// Raíz del árbol a recorrer
+    Empresa* raiz;
+    /// Cota inferior del rango
+    string desde;
+    /// Cota superior del rango
+    string hasta;
+
+public:
+    /**
+     * @brief Constructor del rango.
+     * @param r Raíz del árbol.
+     * @param d Ticker inicial (inclusive).
+     * @param h Ticker final (inclusive).
+     */
+    RangoEmpresas(Empresa* r, const string& d, const string& h) : raiz(r), desde(d), hasta(h) {}
+
+    /// @brief Iterador a la primera empresa del rango.
+    IteradorEmpresas begin() const { return IteradorEmpresas(raiz, &desde, &hasta); }
+    /// @brief Iterador de fin.
+    IteradorEmpresas end() const { return IteradorEmpresas(); }
+};
+
+/**
+ * @brief Árbol binario de búsqueda (ABB) balanceado tipo AVL para gestionar empresas.
+ *
+ * Tras cada inserción se restaura la propiedad AVL (diferencia de alturas entre
+ * subárboles de a lo sumo 1), de modo que la profundidad es O(log n) aunque los
+ * tickers lleguen ordenados.
  */
 class ABBEmpresas {
 private:
+    /// Semilla con la que se generó el mercado inicial
+    uint64_t semillaMercado;
+    /// Pool de nodos de empresa (memoria contigua, liberación en bloque)
+    PoolNodos<Empresa> poolEmpresas;
+    /// Pool de bloques de historial compartido por todas las empresas
+    PoolNodos<BloqueHistorial> poolHistorial;
+    /// Pools de bloques de historial de los hilos de simulación 1..n-1 (el hilo 0 usa poolHistorial)
+    vector<unique_ptr<PoolNodos<BloqueHistorial>>> poolsHilos;
+    /// Archivos proyectados cuyos bloques de historial se usan en el lugar (ver conservarArchivo)
+    vector<unique_ptr<ArchivoMapeado>> archivosMapeados;
     /// Puntero a la raíz del ABB
     Empresa* raiz;
 
     /**
-     * @brief Inserta una empresa en el ABB (por ticker).
+     * @brief Crea una empresa dentro del pool, con su historial enlazado al pool de bloques.
+     * @param ticker Ticker de la empresa.
+     * @param nombre Nombre de la empresa.
+     * @param sector Sector de la empresa.
+     * @param precio Precio actual de la acción.
+     * @return Puntero a la nueva empresa (aún fuera del árbol).
+     */
+    Empresa* crearEmpresa(const string& ticker, const string& nombre, const string& sector, float precio) {
+        Empresa* nueva = poolEmpresas.crear(ticker, nombre, sector, precio);
+        nueva->historialPrecios.pool = &poolHistorial;
+        return nueva;
+    }
+
+    /// @brief Asegura un pool de bloques por hilo para `hilos` hilos de trabajo.
+    void prepararPoolsHilos(unsigned hilos) {
+        while (poolsHilos.size() + 1 < hilos) poolsHilos.emplace_back(new PoolNodos<BloqueHistorial>());
+    }
+
+    /**
+     * @brief Pool de bloques del hilo h (el 0 usa poolHistorial).
+     *
+     * Los historiales siguen enlazados a poolHistorial: el pool del hilo solo se
+     * pasa a agregarPrecio durante el lote. Todos los pools son del árbol y se
+     * liberan juntos en el destructor.
+     */
+    PoolNodos<BloqueHistorial>* poolDeHilo(unsigned h) { return h == 0 ? &poolHistorial : poolsHilos[h - 1].get(); }
+    /// Nombres de los sectores indexados por su identificador (inicia con SECTORES_EMPRESA)
+    vector<string> nombresSectores;
+    /// Índice secundario: empresas de cada sector, ordenadas por ticker
+    vector<vector<Empresa*>> empresasPorSector;
+    /// Índice secundario: empresas ordenadas por (precio actual, ticker)
+    set<pair<float, Empresa*>, ComparaPrecio> indicePrecio;
+    /// Agregados de precio por sector, indexados por identificador de sector
+    vector<AgregadoSector> agregadosSector;
+
+    /**
+     * @brief Agrupa un lote de noticias por sector, conservando su orden.
+     * @param ajustes Noticias en orden de aplicación.
+     * @return Por identificador de sector, la cadena de (porcentaje, fecha) de sus noticias.
+     */
+    vector<vector<pair<float, Fecha>>> cadenasPorSector(const vector<AjusteNoticia>& ajustes) const {
+        vector<vector<pair<float, Fecha>>> porSector(nombresSectores.size());
+        for (const AjusteNoticia& a : ajustes) {
+            int id = idSector(a.sector);
+            if (id >= 0) porSector[id].push_back({porcentajePorImpacto(a.impacto), a.fecha});
+        }
+        return porSector;
+    }
+
+    /**
+     * @brief Aplica a una empresa la cadena de ajustes de su sector, agregando cada precio al historial.
+     *
+     * Solo toca el historial de la empresa, así que hilos distintos pueden
+     * aplicar cadenas a empresas distintas a la vez; el precio actual y los
+     * índices los actualiza después quien llama (fijarPrecio).
+     * @param e Empresa.
+     * @param precio Precio de partida.
+     * @param cadena Ajustes (porcentaje, fecha) en orden.
+     * @param pool Pool de bloques del hilo.
+     * @return Precio final.
+     */
+    static float aplicarCadena(Empresa* e, float precio, const vector<pair<float, Fecha>>& cadena,
+                               PoolNodos<BloqueHistorial>* pool) {
+        for (const auto& ajuste : cadena) {
+            float nuevoPrecio = precio + precio * ajuste.first;
+            if (nuevoPrecio < 1.0) nuevoPrecio = 1.0;
+            precio = nuevoPrecio;
+            e->historialPrecios.agregarPrecio(ajuste.second, precio, pool);
+        }
+        return precio;
+    }
+
+    /**
+     * @brief Porcentaje de ajuste de precio según el impacto de una noticia.
+     * @param impacto Impacto de la noticia (1-10).
+     * @return Porcentaje como valor decimal (de -5% a +5%).
+     */
+    static float porcentajePorImpacto(int impacto) {
+        if (impacto > 5)
+            return (impacto - 5) * 0.01;
+        else
+            return -(6 - impacto) * 0.01;
+    }
+
+    /**
+     * @brief Cambia el precio actual de una empresa manteniendo el índice por precio.
+     *
+     * Toda modificación de precioActual debe pasar por aquí: el índice usa el
+     * precio como clave y quedaría inconsistente si se cambia directamente.
+     * @param emp Empresa a actualizar.
+     * @param precio Nuevo precio actual.
+     */
+    void fijarPrecio(Empresa* emp, float precio) {
+        if (emp->precioActual == precio) return;
+        indicePrecio.erase({emp->precioActual, emp});
+        agregadosSector[emp->sectorId].actualizar(emp->precioActual, precio);
+        emp->precioActual = precio;
+        indicePrecio.insert({precio, emp});
+    }
+
+    /**
+     * @brief Obtiene el identificador de un sector, registrándolo si es nuevo.
+     * @param sector Nombre del sector.
+     * @return Identificador del sector.
+     */
+    int registrarSector(const string& sector) {
+        int id = idSector(sector);
+        if (id >= 0) return id;
+        nombresSectores.push_back(sector);
+        empresasPorSector.emplace_back();
+        agregadosSector.emplace_back();
+        return (int)nombresSectores.size() - 1;
+    }
+
+    /**
+     * @brief Agrega una empresa recién insertada al índice por sector.
+     * @param emp Empresa a indexar.
+     */
+    void indexarEmpresa(Empresa* emp) {
+        emp->sectorId = registrarSector(emp->sector);
+        vector<Empresa*>& lista = empresasPorSector[emp->sectorId];
+        auto pos = lower_bound(lista.begin(), lista.end(), emp,
+                               [](const Empresa* a, const Empresa* b) { return a->ticker < b->ticker; });
+        lista.insert(pos, emp);
+        indicePrecio.insert({emp->precioActual, emp});
+        agregadosSector[emp->sectorId].agregar(emp->precioActual);
+    }
+
+    /**
+     * @brief Altura de un subárbol (0 si es vacío).
+     * @param nodo Raíz del subárbol.
+     * @return Altura del subárbol.
+     */
+    static int alturaDe(Empresa* nodo) {
+        return nodo ? nodo->altura : 0;
+    }
+
+    /**
+     * @brief Recalcula la altura de un nodo a partir de la de sus hijos.
+     * @param nodo Nodo a actualizar.
+     */
+    static void actualizarAltura(Empresa* nodo) {
+        nodo->altura = 1 + max(alturaDe(nodo->izquierda), alturaDe(nodo->derecha));
+    }
+
+    /**
+     * @brief Rotación simple a la derecha.
+     * @param nodo Raíz del subárbol desbalanceado.
+     * @return Nueva raíz del subárbol.
+     */
+    static Empresa* rotarDerecha(Empresa* nodo) {
+        Empresa* nuevaRaiz = nodo->izquierda;
+        nodo->izquierda = nuevaRaiz->derecha;
+        nuevaRaiz->derecha = nodo;
+        actualizarAltura(nodo);
+        actualizarAltura(nuevaRaiz);
+        return nuevaRaiz;
+    }
+
+    /**
+     * @brief Rotación simple a la izquierda.
+     * @param nodo Raíz del subárbol desbalanceado.
+     * @return Nueva raíz del subárbol.
+     */
+    static Empresa* rotarIzquierda(Empresa* nodo) {
+        Empresa* nuevaRaiz = nodo->derecha;
+        nodo->derecha = nuevaRaiz->izquierda;
+        nuevaRaiz->izquierda = nodo;
+        actualizarAltura(nodo);
+        actualizarAltura(nuevaRaiz);
+        return nuevaRaiz;
+    }
+
+    /**
+     * @brief Restaura la propiedad AVL en un nodo aplicando las rotaciones necesarias.
+     * @param nodo Nodo cuyos hijos ya están balanceados.
+     * @return Nueva raíz del subárbol.
+     */
+    static Empresa* balancear(Empresa* nodo) {
+        actualizarAltura(nodo);
+        int factor = alturaDe(nodo->izquierda) - alturaDe(nodo->derecha);
+        if (factor > 1) {
+            // Caso izquierda-derecha: se reduce a izquierda-izquierda
+            if (alturaDe(nodo->izquierda->izquierda) < alturaDe(nodo->izquierda->derecha))
+                nodo->izquierda = rotarIzquierda(nodo->izquierda);
+            return rotarDerecha(nodo);
+        }
+        if (factor < -1) {
+            // Caso derecha-izquierda: se reduce a derecha-derecha
+            if (alturaDe(nodo->derecha->derecha) < alturaDe(nodo->derecha->izquierda))
+                nodo->derecha = rotarDerecha(nodo->derecha);
+            return rotarIzquierda(nodo);
+        }
+        return nodo;
+    }
+
+    /**
+     * @brief Inserta una empresa en el ABB (por ticker) y rebalancea el camino de vuelta.
      * @param nodo Nodo actual.
      * @param nueva Nueva empresa a insertar.
      * @return Puntero al nodo actualizado.
@@ -137,54 +1181,42 @@ private:
             nodo->izquierda = insertar(nodo->izquierda, nueva);
         else if (nueva->ticker > nodo->ticker)
             nodo->derecha = insertar(nodo->derecha, nueva);
-        // Si es igual, no inserta duplicados
-        return nodo;
+        else
+            return nodo; // Si es igual, no inserta duplicados
+        return balancear(nodo);
     }
 
     /**
-     * @brief Busca una empresa por ticker en el ABB.
-     * @param nodo Nodo actual.
+     * @brief Busca una empresa por ticker en el ABB (de forma iterativa).
      * @param ticker Ticker a buscar.
      * @return Puntero a la empresa encontrada o nullptr.
      */
-    Empresa* buscar(Empresa* nodo, const string& ticker) {
-        if (!nodo) return nullptr;
-        if (ticker < nodo->ticker)
-            return buscar(nodo->izquierda, ticker);
-        else if (ticker > nodo->ticker)
-            return buscar(nodo->derecha, ticker);
-        else
-            return nodo;
-    }
-
-    /**
-     * @brief Recorrido inorden para obtener empresas ordenadas alfabéticamente.
-     * @param nodo Nodo actual.
-     * @param lista Vector donde se almacenan las empresas.
-     */
-    void inorden(Empresa* nodo, vector<Empresa*>& lista) {
-        if (!nodo) return;
-        inorden(nodo->izquierda, lista);
-        lista.push_back(nodo);
-        inorden(nodo->derecha, lista);
+    Empresa* buscar(const string& ticker) const {
+        Empresa* nodo = raiz;
+        while (nodo) {
+            int cmp = ticker.compare(nodo->ticker);
+            if (cmp < 0) nodo = nodo->izquierda;
+            else if (cmp > 0) nodo = nodo->derecha;
+            else return nodo;
+        }
+        return nullptr;
     }
 
     /**
-     * @brief Libera la memoria de todos los nodos del ABB y sus listas de precios.
-     * @param nodo Nodo actual.
+     * @brief Construye un árbol perfectamente balanceado a partir de empresas ordenadas por ticker.
+     * @param empresas Vector de empresas ordenado por ticker y sin duplicados.
+     * @param ini Índice inicial (inclusive).
+     * @param fin Índice final (exclusive).
+     * @return Raíz del subárbol construido.
      */
-    void destruir(Empresa* nodo) {
-        if (!nodo) return;
-        destruir(nodo->izquierda);
-        destruir(nodo->derecha);
-        // Liberar multilista de precios
-        NodoPrecio* p = nodo->historialPrecios.cabeza;
-        while (p) {
-            NodoPrecio* temp = p;
-            p = p->siguiente;
-            delete temp;
-        }
-        delete nodo;
+    static Empresa* construirBalanceado(const vector<Empresa*>& empresas, size_t ini, size_t fin) {
+        if (ini >= fin) return nullptr;
+        size_t medio = ini + (fin - ini) / 2;
+        Empresa* nodo = empresas[medio];
+        nodo->izquierda = construirBalanceado(empresas, ini, medio);
+        nodo->derecha = construirBalanceado(empresas, medio + 1, fin);
+        actualizarAltura(nodo);
+        return nodo;
     }
 
     /**
@@ -207,49 +1239,247 @@ private:
             "Verizon","Intel","Comcast","Honeywell","Oracle","Amgen","Qualcomm","Medtronic","Union Pacific","Lowe's"
         };
 
-        srand(time(nullptr));
+        // Cada ticker tiene su propio flujo aleatorio: el resultado no depende del reparto entre hilos
+        vector<GeneradorAleatorio> flujos;
+        vector<Empresa*> empresas;
         for (int i = 0; i < 50; ++i) {
-            float precio = 50 + rand() % 450 + (rand() % 1000) / 1000.0f; // Precio entre 50 y 500 aprox
-            string sector = SECTORES_EMPRESA[rand() % SECTORES_EMPRESA.size()];
+            GeneradorAleatorio flujo(semillaMercado, hashTexto(tickers[i]));
+            float precio = 50 + flujo.menorQue(450) + flujo.menorQue(1000) / 1000.0f; // Precio entre 50 y 500 aprox
+            string sector = SECTORES_EMPRESA[flujo.menorQue(SECTORES_EMPRESA.size())];
             insertarEmpresa(tickers[i], nombres[i], sector, precio);
+            empresas.push_back(buscarEmpresa(tickers[i]));
+            flujos.push_back(flujo);
+        }
 
-            // Generar historial de precios solo para el último mes: 2025-05-01 a 2025-05-26
-            Empresa* emp = buscarEmpresa(tickers[i]);
-            int year = 2025, month = 5, day = 1;
-            float precioHist = precio;
-            while (!(year == 2025 && month == 5 && day == 27)) { // hasta el 26 inclusive
-                string fecha = "";
-                fecha += "2025-";
-                if (month < 10) fecha += "0";
-                fecha += to_string(month) + "-";
-                if (day < 10) fecha += "0";
-                fecha += to_string(day);
-
-                float variacion = ((rand() % 2001) - 1000) / 100.0f; // -10.00 a +10.00
-                precioHist = max(1.0f, precioHist + variacion);
-                emp->historialPrecios.agregarPrecio(fecha, precioHist);
-
-                day++;
-                if (day > 26) break; // Solo hasta el 26 de mayo
+        // Generar historial de precios solo para el último mes: 2025-05-01 a 2025-05-26
+        unsigned hilos = min<unsigned>(hilosDisponibles(), empresas.size());
+        prepararPoolsHilos(hilos);
+        ejecutarEnParalelo(hilos, [&](unsigned h) {
+            PoolNodos<BloqueHistorial>* pool = poolDeHilo(h);
+            const Fecha inicio = Fecha::desdeCivil(2025, 5, 1), fin = Fecha::desdeCivil(2025, 5, 26);
+            // Una variación por día del rango, reservada una sola vez por hilo
+            vector<int> variaciones(fin - inicio + 1);
+            for (size_t i = empresas.size() * h / hilos; i < empresas.size() * (h + 1) / hilos; ++i) {
+                Empresa* emp = empresas[i];
+                flujos[i].llenar(variaciones.data(), variaciones.size(), -1000, 1000);
+                float precioHist = emp->precioActual;
+                for (Fecha fecha = inicio; fecha <= fin; fecha = fecha + 1) {
+                    float variacion = variaciones[fecha - inicio] / 100.0f; // -10.00 a +10.00
+                    precioHist = max(1.0f, precioHist + variacion);
+                    emp->historialPrecios.agregarPrecio(fecha, precioHist, pool);
+                }
             }
-            // Actualizar precio actual al último histórico
-            if (emp->historialPrecios.cabeza)
-                emp->precioActual = emp->historialPrecios.cabeza->precioCierre;
+        });
+        // Actualizar precio actual al último histórico
+        for (Empresa* emp : empresas) {
+            if (!emp->historialPrecios.vacio())
+                fijarPrecio(emp, emp->historialPrecios.ultimoPrecio());
+        }
+    }
+
+    /**
+     * @brief Ticker sintético de ancho fijo: el orden alfabético coincide con el numérico.
+     * @param indice Número de la empresa.
+     * @param ancho Cantidad de letras.
+     * @return Ticker en letras mayúsculas (AAA, AAB, ...).
+     */
+    static string tickerSintetico(size_t indice, int ancho) {
+        string ticker(ancho, 'A');
+        for (int k = ancho - 1; k >= 0; --k) {
+            ticker[k] = 'A' + indice % 26;
+            indice /= 26;
+        }
+        return ticker;
+    }
+
+    /**
+     * @brief Genera un mercado sintético según la configuración.
+     *
+     * Los precios siguen un movimiento browniano geométrico diario con la deriva
+     * y volatilidad del sector de cada empresa. La empresa i usa el flujo
+     * aleatorio (semilla, i), así que el mercado es el mismo con cualquier
+     * número de hilos.
+     * @param config Tamaño, fechas, semilla y parámetros por sector.
+     */
+    void generarMercado(const ConfiguracionMercado& config) {
+        const size_t n = config.empresas;
+        const size_t numSectores = min(config.sectores.size(), SECTORES_EMPRESA.size());
+        if (n == 0 || numSectores == 0) return;
+        int ancho = 3;
+        for (size_t capacidad = 26 * 26 * 26; capacidad < n; capacidad *= 26) ancho++;
+
+        // Datos de cada empresa; los tickers ya salen ordenados para la carga masiva
+        vector<DatosEmpresa> datos(n);
+        vector<GeneradorAleatorio> flujos(n);
+        unsigned hilos = min<size_t>(hilosDisponibles(), n);
+        ejecutarEnParalelo(hilos, [&](unsigned h) {
+            for (size_t i = n * h / hilos; i < n * (h + 1) / hilos; ++i) {
+                flujos[i] = GeneradorAleatorio(config.semilla, i);
+                datos[i].ticker = tickerSintetico(i, ancho);
+                datos[i].nombre = "Empresa " + datos[i].ticker;
+                datos[i].sector = SECTORES_EMPRESA[flujos[i].menorQue(numSectores)];
+                datos[i].precio = config.precioMinimo + (config.precioMaximo - config.precioMinimo) * flujos[i].real();
+            }
+        });
+        cargarEmpresasOrdenadas(datos);
+        vector<Empresa*> empresas = obtenerEmpresasOrdenadas();
+        if (empresas.size() != n) return;  // Ya había empresas con esos tickers
+
+        // Historiales en paralelo, cada hilo con su pool de bloques
+        prepararPoolsHilos(hilos);
+        const int32_t primerDia = config.inicio.indiceHabil();
+        const double dt = 1.0 / 252;  // Días hábiles por año
+        ejecutarEnParalelo(hilos, [&](unsigned h) {
+            PoolNodos<BloqueHistorial>* pool = poolDeHilo(h);
+            vector<float> normales(config.dias > 0 ? config.dias : 0);
+            for (size_t i = n * h / hilos; i < n * (h + 1) / hilos; ++i) {
+                Empresa* emp = empresas[i];
+                const ParametrosSector& p = config.sectores[emp->sectorId];
+                const double tendencia = (p.deriva - 0.5 * p.volatilidad * p.volatilidad) * dt;
+                const double escala = p.volatilidad * sqrt(dt);
+                flujos[i].llenarNormales(normales.data(), normales.size());
+                double precio = emp->precioActual;
+                for (size_t d = 0; d < normales.size(); ++d) {
+                    precio *= exp(tendencia + escala * normales[d]);
+                    emp->historialPrecios.agregarPrecio(Fecha::desdeIndiceHabil(primerDia + d), (float)precio, pool);
+                }
+            }
+        });
+        for (Empresa* emp : empresas) {
+            if (!emp->historialPrecios.vacio())
+                fijarPrecio(emp, emp->historialPrecios.ultimoPrecio());
         }
     }
 
 public:
     /**
      * @brief Constructor de ABBEmpresas. Inicializa el árbol con empresas de ejemplo.
+     * @param semilla Semilla del mercado generado; la misma semilla reproduce los mismos precios.
      */
-    ABBEmpresas() : raiz(nullptr) {
+    explicit ABBEmpresas(uint64_t semilla = semillaPorTiempo())
+        : semillaMercado(semilla), raiz(nullptr), nombresSectores(SECTORES_EMPRESA), empresasPorSector(SECTORES_EMPRESA.size()),
+          agregadosSector(SECTORES_EMPRESA.size()) {
         inicializarEmpresas();
     }
 
+    /**
+     * @brief Constructor con un mercado sintético (para pruebas de capacidad).
+     * @param config Número de empresas y días, semilla y parámetros por sector.
+     */
+    explicit ABBEmpresas(const ConfiguracionMercado& config)
+        : semillaMercado(config.semilla), raiz(nullptr), nombresSectores(SECTORES_EMPRESA),
+          empresasPorSector(SECTORES_EMPRESA.size()), agregadosSector(SECTORES_EMPRESA.size()) {
+        generarMercado(config);
+    }
+
     /**
      * @brief Destructor de ABBEmpresas. Libera toda la memoria utilizada.
      */
-    ~ABBEmpresas() { destruir(raiz); }
+    ~ABBEmpresas() {
+        // Primero las empresas (sus historiales no liberan bloques) y luego los historiales, en bloque
+        poolEmpresas.liberarTodo();
+        poolHistorial.liberarTodo();
+        for (auto& pool : poolsHilos) pool->liberarTodo();
+    }
+
+    ABBEmpresas(const ABBEmpresas&) = delete;
+    ABBEmpresas& operator=(const ABBEmpresas&) = delete;
+
+    /// @brief Semilla con la que se generó el mercado (para reproducir la ejecución).
+    uint64_t semilla() const { return semillaMercado; }
+
+    /// @brief Reemplaza la semilla del mercado (al restaurar una instantánea).
+    void fijarSemilla(uint64_t semilla) { semillaMercado = semilla; }
+
+    /// @brief Indica si el mercado no tiene empresas.
+    bool vacio() const { return raiz == nullptr; }
+
+    /**
+     * @brief Mantiene vivo un archivo proyectado mientras exista el mercado.
+     *
+     * Los historiales que adoptan bloques del archivo (HistorialPrecios::cargarEstado)
+     * apuntan a su memoria, así que se entrega antes de adoptarlos.
+     * @param archivo Archivo proyectado.
+     */
+    void conservarArchivo(unique_ptr<ArchivoMapeado> archivo) { archivosMapeados.push_back(std::move(archivo)); }
+
+    /**
+     * @brief Carga historiales de precios externos (por ejemplo, de archivos CSV).
+     *
+     * Los tickers que no existen se crean con una carga masiva (nombre igual al
+     * ticker y sector "Sin sector" si la serie no lo trae). Cada serie se ordena
+     * por fecha si hace falta y se agrega al final del historial de su empresa;
+     * si una fecha aparece varias veces (por ejemplo, el mismo día en dos
+     * archivos) queda solo el último registro. Las series se reparten entre
+     * hilos por cantidad de registros. El precio actual pasa a ser el último cierre.
+     * @param series Series a cargar, una por ticker.
+     * @param hilos Número de hilos de trabajo.
+     * @return Registros descartados por tener una fecha repetida.
+     */
+    size_t cargarHistoriales(vector<SeriePrecios>& series, unsigned hilos = hilosDisponibles()) {
+        if (series.empty()) return 0;
+        vector<DatosEmpresa> nuevas;
+        for (const SeriePrecios& serie : series) {
+            if (serie.precios.empty() || buscar(serie.ticker)) continue;
+            nuevas.push_back({serie.ticker, serie.ticker, serie.sector.empty() ? "Sin sector" : serie.sector,
+                              serie.precios.back()});
+        }
+        if (!nuevas.empty()) cargarEmpresasOrdenadas(nuevas);
+
+        vector<Empresa*> destino(series.size());
+        vector<size_t> pesos(series.size());
+        for (size_t i = 0; i < series.size(); ++i) {
+            destino[i] = buscar(series[i].ticker);
+            pesos[i] = series[i].precios.size();
+        }
+        if (hilos == 0) hilos = 1;
+        if (hilos > series.size()) hilos = series.size();
+        prepararPoolsHilos(hilos);
+        vector<size_t> cortes = repartirPorPeso(pesos, hilos);
+        vector<size_t> repetidos(hilos, 0);
+        ejecutarEnParalelo(hilos, [&](unsigned h) {
+            PoolNodos<BloqueHistorial>* pool = poolDeHilo(h);
+            vector<size_t> orden;
+            for (size_t i = cortes[h]; i < cortes[h + 1]; ++i) {
+                SeriePrecios& serie = series[i];
+                Empresa* emp = destino[i];
+                if (!emp) continue;
+                size_t n = serie.precios.size();
+                bool ordenada = is_sorted(serie.fechas.begin(), serie.fechas.end());
+                if (!ordenada) {
+                    orden.resize(n);
+                    for (size_t k = 0; k < n; ++k) orden[k] = k;
+                    stable_sort(orden.begin(), orden.end(), [&](size_t a, size_t b) { return serie.fechas[a] < serie.fechas[b]; });
+                }
+                for (size_t j = 0; j < n; ++j) {
+                    size_t k = ordenada ? j : orden[j];
+                    // A igual fecha se conserva el orden de lectura: gana el último registro
+                    if (j + 1 < n && serie.fechas[ordenada ? j + 1 : orden[j + 1]] == serie.fechas[k]) {
+                        repetidos[h]++;
+                        continue;
+                    }
+                    emp->historialPrecios.agregarPrecio(serie.fechas[k], serie.precios[k], pool);
+                }
+            }
+        });
+        for (Empresa* emp : destino) {
+            if (emp && !emp->historialPrecios.vacio())
+                fijarPrecio(emp, emp->historialPrecios.ultimoPrecio());
+        }
+        size_t descartados = 0;
+        for (size_t r : repetidos) descartados += r;
+        return descartados;
+    }
+
+    /**
+     * @brief Número de nodos de empresa y de bloques de historial reservados en los pools.
+     * @return Par (empresas, bloques de historial).
+     */
+    pair<size_t, size_t> nodosReservados() const {
+        size_t bloques = poolHistorial.cantidad();
+        for (const auto& pool : poolsHilos) bloques += pool->cantidad();
+        return {poolEmpresas.cantidad(), bloques};
+    }
 
     /**
      * @brief Inserta una empresa (si no existe ya en el ABB).
@@ -260,8 +1490,9 @@ public:
      */
     void insertarEmpresa(const string& ticker, const string& nombre, const string& sector, float precio) {
         if (!buscarEmpresa(ticker)) {
-            Empresa* nueva = new Empresa(ticker, nombre, sector, precio);
+            Empresa* nueva = crearEmpresa(ticker, nombre, sector, precio);
             raiz = insertar(raiz, nueva);
+            indexarEmpresa(nueva);
         }
     }
 
@@ -271,7 +1502,99 @@ public:
      * @return Puntero a la empresa encontrada o nullptr.
      */
     Empresa* buscarEmpresa(const string& ticker) {
-        return buscar(raiz, ticker);
+        return buscar(ticker);
+    }
+
+    /**
+     * @brief Carga masiva de empresas en O(n + m).
+     *
+     * Mezcla las empresas ya existentes con las nuevas (ambas ordenadas por ticker)
+     * y reconstruye un árbol perfectamente balanceado. Si un ticker ya existe se
+     * conserva la empresa actual, igual que en insertarEmpresa. Si la entrada no
+     * viene ordenada se ordena primero (O(m log m)).
+     * @param datos Empresas a cargar, idealmente ordenadas por ticker.
+     */
+    void cargarEmpresasOrdenadas(const vector<DatosEmpresa>& datos) {
+        vector<const DatosEmpresa*> nuevos;
+        nuevos.reserve(datos.size());
+        bool ordenados = true;
+        for (size_t i = 0; i < datos.size(); ++i) {
+            if (i > 0 && datos[i].ticker < datos[i - 1].ticker) ordenados = false;
+            nuevos.push_back(&datos[i]);
+        }
+        if (!ordenados) {
+            stable_sort(nuevos.begin(), nuevos.end(),
+                        [](const DatosEmpresa* a, const DatosEmpresa* b) { return a->ticker < b->ticker; });
+        }
+
+        vector<Empresa*> existentes = obtenerEmpresasOrdenadas();
+        vector<Empresa*> mezcla;
+        mezcla.reserve(existentes.size() + nuevos.size());
+        size_t i = 0, j = 0;
+        while (i < existentes.size() || j < nuevos.size()) {
+            if (j == nuevos.size() || (i < existentes.size() && existentes[i]->ticker <= nuevos[j]->ticker)) {
+                // Un ticker repetido en la entrada se descarta: gana la empresa existente
+                if (j < nuevos.size() && existentes[i]->ticker == nuevos[j]->ticker) ++j;
+                else mezcla.push_back(existentes[i++]);
+            } else {
+                const DatosEmpresa* d = nuevos[j++];
+                if (!mezcla.empty() && mezcla.back()->ticker == d->ticker) continue;
+                mezcla.push_back(crearEmpresa(d->ticker, d->nombre, d->sector, d->precio));
+            }
+        }
+        raiz = construirBalanceado(mezcla, 0, mezcla.size());
+
+        // La mezcla ya está ordenada por ticker: se reconstruye el índice por sector en O(n)
+        for (auto& lista : empresasPorSector) lista.clear();
+        for (auto& agregado : agregadosSector) agregado = AgregadoSector();
+        indicePrecio.clear();
+        for (Empresa* e : mezcla) {
+            e->sectorId = registrarSector(e->sector);
+            empresasPorSector[e->sectorId].push_back(e);
+            indicePrecio.insert({e->precioActual, e});
+            agregadosSector[e->sectorId].agregar(e->precioActual);
+        }
+    }
+
+    /**
+     * @brief Devuelve el identificador numérico de un sector.
+     * @param sector Nombre del sector.
+     * @return Identificador del sector, o -1 si no está registrado.
+     */
+    int idSector(const string& sector) const {
+        for (size_t i = 0; i < nombresSectores.size(); ++i)
+            if (nombresSectores[i] == sector) return (int)i;
+        return -1;
+    }
+
+    /**
+     * @brief Devuelve las empresas de un sector, ordenadas por ticker, sin recorrer el árbol.
+     * @param sector Nombre del sector.
+     * @return Referencia a la lista del índice (vacía si el sector no existe).
+     */
+    const vector<Empresa*>& obtenerEmpresasPorSector(const string& sector) const {
+        static const vector<Empresa*> vacia;
+        int id = idSector(sector);
+        return (id >= 0) ? empresasPorSector[id] : vacia;
+    }
+
+    /**
+     * @brief Devuelve los sectores que tienen al menos una empresa registrada.
+     * @return Vector con los nombres de los sectores, en orden de identificador.
+     */
+    vector<string> obtenerSectores() const {
+        vector<string> sectores;
+        for (size_t i = 0; i < nombresSectores.size(); ++i)
+            if (!empresasPorSector[i].empty()) sectores.push_back(nombresSectores[i]);
+        return sectores;
+    }
+
+    /**
+     * @brief Devuelve la profundidad del árbol (0 si está vacío).
+     * @return Número de niveles del árbol.
+     */
+    int profundidad() const {
+        return alturaDe(raiz);
     }
 
     /**
@@ -280,21 +1603,83 @@ public:
      * @param fecha Fecha del precio.
      * @param precio Precio de cierre.
      */
-    void agregarPrecio(const string& ticker, const string& fecha, float precio) {
+    void agregarPrecio(const string& ticker, Fecha fecha, float precio) {
         Empresa* emp = buscarEmpresa(ticker);
         if (emp) {
             emp->historialPrecios.agregarPrecio(fecha, precio);
-            emp->precioActual = precio;
+            fijarPrecio(emp, precio);
+        }
+    }
+
+    /// @brief Fecha más reciente de todos los historiales (Fecha() si no hay registros).
+    Fecha ultimaFecha() const {
+        Fecha ultima;
+        bool alguna = false;
+        for (Empresa* e : *this) {
+            if (e->historialPrecios.vacio()) continue;
+            if (!alguna || ultima < e->historialPrecios.ultimaFecha()) ultima = e->historialPrecios.ultimaFecha();
+            alguna = true;
         }
+        return ultima;
+    }
+
+    /**
+     * @brief Iterador a la primera empresa en orden de ticker (permite usar for (Empresa* e : arbol)).
+     * @return Iterador inorden sin reserva de memoria.
+     */
+    IteradorEmpresas begin() const { return IteradorEmpresas(raiz); }
+
+    /**
+     * @brief Iterador de fin del recorrido.
+     * @return Iterador terminado.
+     */
+    IteradorEmpresas end() const { return IteradorEmpresas(); }
+
+    /**
+     * @brief Devuelve el rango de empresas con ticker en [desde, hasta] para recorrerlo con for.
+     * @param desde Ticker inicial (inclusive).
+     * @param hasta Ticker final (inclusive).
+     * @return Rango recorrible en O(log n + k).
+     */
+    RangoEmpresas rango(const string& desde, const string& hasta) const {
+        return RangoEmpresas(raiz, desde, hasta);
+    }
+
+    /**
+     * @brief Visita las empresas en orden de ticker hasta que el visitante pida parar.
+     * @param visitar Función que recibe Empresa* y devuelve false para detener el recorrido.
+     * @return true si se recorrió todo, false si el visitante detuvo el recorrido.
+     */
+    template <typename Visitante>
+    bool recorrer(Visitante visitar) const {
+        for (IteradorEmpresas it = begin(); it != end(); ++it)
+            if (!visitar(*it)) return false;
+        return true;
+    }
+
+    /**
+     * @brief Visita las empresas con ticker en [desde, hasta] hasta que el visitante pida parar.
+     * @param desde Ticker inicial (inclusive).
+     * @param hasta Ticker final (inclusive).
+     * @param visitar Función que recibe Empresa* y devuelve false para detener el recorrido.
+     * @return true si se recorrió todo el rango, false si el visitante lo detuvo.
+     */
+    template <typename Visitante>
+    bool recorrerRango(const string& desde, const string& hasta, Visitante visitar) const {
+        for (Empresa* e : rango(desde, hasta))
+            if (!visitar(e)) return false;
+        return true;
     }
 
     /**
      * @brief Devuelve una lista ordenada de empresas (inorden).
+     *
+     * Copia todo el universo; para solo recorrerlo es preferible usar el iterador o recorrer().
      * @return Vector de punteros a empresas ordenadas alfabéticamente.
      */
-    vector<Empresa*> obtenerEmpresasOrdenadas() {
+    vector<Empresa*> obtenerEmpresasOrdenadas() const {
         vector<Empresa*> lista;
-        inorden(raiz, lista);
+        for (Empresa* e : *this) lista.push_back(e);
         return lista;
     }
 
@@ -302,11 +1687,10 @@ public:
      * @brief Imprime todas las empresas y su precio actual por consola.
      */
     void imprimirEmpresas() {
-        vector<Empresa*> lista = obtenerEmpresasOrdenadas();
         cout << "---------------------------------------------------------------\n";
         cout << " Ticker   | Empresa                  | Sector         | Precio actual\n";
         cout << "---------------------------------------------------------------\n";
-        for (auto e : lista) {
+        for (auto e : *this) {
             // Ticker (máx 8)
             cout << " ";
             int t = 0;
@@ -366,17 +1750,15 @@ public:
 
     /**
      * @brief Imprime empresas ordenadas por precio actual (de mayor a menor).
-     * @param arr Vector de empresas.
-     * @param left Índice izquierdo.
-     * @param right Índice derecho.
+     *
+     * Recorre el índice por precio en orden inverso, sin copiar ni reordenar.
      */
     void imprimirPorPrecio() {
-        vector<Empresa*> lista = obtenerEmpresasOrdenadas();
-        mergeSort(lista, 0, lista.size() - 1);
         cout << "---------------------------------------------------------------\n";
         cout << " Ticker   | Empresa                  | Sector         | Precio actual\n";
         cout << "---------------------------------------------------------------\n";
-        for (auto e : lista) {
+        for (auto it = indicePrecio.rbegin(); it != indicePrecio.rend(); ++it) {
+            Empresa* e = it->second;
             // Ticker (máx 8)
             cout << " ";
             int t = 0;
@@ -402,94 +1784,104 @@ public:
      * @param sector Nombre del sector a filtrar.
      */
     void imprimirEmpresasPorSector(const string& sector) {
-        vector<Empresa*> lista = obtenerEmpresasOrdenadas();
+        const vector<Empresa*>& lista = obtenerEmpresasPorSector(sector);
         cout << "---------------------------------------------------------------\n";
         cout << " Ticker   | Empresa                  | Sector         | Precio actual\n";
         cout << "---------------------------------------------------------------\n";
         for (auto e : lista) {
-            if (e->sector == sector) {
-                // Ticker (máx 8)
-                cout << " ";
-                int t = 0;
-                for (; t < 8 && e->ticker[t] != '\0'; ++t) cout << e->ticker[t];
-                for (; t < 8; ++t) cout << " ";
-                cout << " | ";
-                // Nombre (máx 24)
-                int n = 0;
-                for (; n < 24 && e->nombre[n] != '\0'; ++n) cout << e->nombre[n];
-                for (; n < 24; ++n) cout << " ";
-                cout << " | ";
-                // Sector (máx 14)
-                int s = 0;
-                for (; s < 14 && e->sector[s] != '\0'; ++s) cout << e->sector[s];
-                for (; s < 14; ++s) cout << " ";
-                cout << " | " << e->precioActual << endl;
-            }
+            // Ticker (máx 8)
+            cout << " ";
+            int t = 0;
+            for (; t < 8 && e->ticker[t] != '\0'; ++t) cout << e->ticker[t];
+            for (; t < 8; ++t) cout << " ";
+            cout << " | ";
+            // Nombre (máx 24)
+            int n = 0;
+            for (; n < 24 && e->nombre[n] != '\0'; ++n) cout << e->nombre[n];
+            for (; n < 24; ++n) cout << " ";
+            cout << " | ";
+            // Sector (máx 14)
+            int s = 0;
+            for (; s < 14 && e->sector[s] != '\0'; ++s) cout << e->sector[s];
+            for (; s < 14; ++s) cout << " ";
+            cout << " | " << e->precioActual << endl;
         }
         cout << "---------------------------------------------------------------\n";
     }
 
+    /**
+     * @brief Devuelve los agregados de precio (suma, cantidad, mínimo, máximo) de un sector en O(1).
+     * @param sector Nombre del sector.
+     * @return Referencia a los agregados del sector (vacíos si el sector no existe).
+     */
+    const AgregadoSector& agregadoPorSector(const string& sector) const {
+        static const AgregadoSector vacio;
+        int id = idSector(sector);
+        return (id >= 0) ? agregadosSector[id] : vacio;
+    }
+
     /**
      * @brief Calcula el promedio del precio actual de las empresas de un sector.
+     *
+     * Se lee de los agregados del sector, sin recorrer sus empresas.
      * @param sector Nombre del sector.
      * @return Promedio del precio actual de las empresas del sector, o 0 si no hay empresas.
      */
     float promedioPrecioPorSector(const string& sector) {
-        vector<Empresa*> lista = obtenerEmpresasOrdenadas();
-        float suma = 0;
-        int cuenta = 0;
-        for (auto e : lista) {
-            if (e->sector == sector) {
-                suma += e->precioActual;
-                cuenta++;
-            }
-        }
-        return (cuenta > 0) ? (suma / cuenta) : 0;
+        return agregadoPorSector(sector).promedio();
     }
 
     /**
-     * @brief Devuelve la empresa con el precio actual más bajo.
+     * @brief Devuelve la empresa con el precio actual más bajo en O(1).
      * @return Puntero a la empresa con el precio más bajo, o nullptr si no hay empresas.
      */
     Empresa* obtenerEmpresaMasBarata() {
-        vector<Empresa*> lista = obtenerEmpresasOrdenadas();
-        if (lista.empty()) return nullptr;
-        Empresa* minEmp = lista[0];
-        for (size_t i = 1; i < lista.size(); ++i) {
-            if (lista[i]->precioActual < minEmp->precioActual)
-                minEmp = lista[i];
-        }
-        return minEmp;
+        if (indicePrecio.empty()) return nullptr;
+        return indicePrecio.begin()->second;
     }
 
     /**
-     * @brief Devuelve la empresa con el precio actual más alto.
+     * @brief Devuelve la empresa con el precio actual más alto en O(1).
      * @return Puntero a la empresa con el precio más alto, o nullptr si no hay empresas.
      */
     Empresa* obtenerEmpresaMasCara() {
-        vector<Empresa*> lista = obtenerEmpresasOrdenadas();
-        if (lista.empty()) return nullptr;
-        Empresa* maxEmp = lista[0];
-        for (size_t i = 1; i < lista.size(); ++i) {
-            if (lista[i]->precioActual > maxEmp->precioActual)
-                maxEmp = lista[i];
+        if (indicePrecio.empty()) return nullptr;
+        return indicePrecio.rbegin()->second;
+    }
+
+    /**
+     * @brief Devuelve las k empresas más caras (o más baratas) sin ordenar todo el universo.
+     * @param k Número máximo de empresas a devolver.
+     * @param descendente true para las más caras primero, false para las más baratas primero.
+     * @return Vector con a lo sumo k empresas ordenadas por precio.
+     */
+    vector<Empresa*> obtenerEmpresasPorPrecio(size_t k, bool descendente = true) {
+        vector<Empresa*> resultado;
+        if (descendente) {
+            for (auto it = indicePrecio.rbegin(); it != indicePrecio.rend() && resultado.size() < k; ++it)
+                resultado.push_back(it->second);
+        } else {
+            for (auto it = indicePrecio.begin(); it != indicePrecio.end() && resultado.size() < k; ++it)
+                resultado.push_back(it->second);
         }
-        return maxEmp;
+        return resultado;
     }
 
     /**
      * @brief Devuelve una lista de empresas cuyo precio actual está en el rango [minPrecio, maxPrecio].
+     *
+     * Usa el índice por precio para encontrarlas en O(log n + k) y las entrega
+     * en orden de ticker, como el recorrido inorden del árbol (O(k log k)).
      * @param minPrecio Precio mínimo.
      * @param maxPrecio Precio máximo.
-     * @return Vector de punteros a empresas dentro del rango.
+     * @return Vector de punteros a empresas dentro del rango, ordenado por ticker.
      */
     vector<Empresa*> buscarEmpresasPorRangoPrecio(float minPrecio, float maxPrecio) {
-        vector<Empresa*> lista = obtenerEmpresasOrdenadas();
         vector<Empresa*> resultado;
-        for (auto e : lista) {
-            if (e->precioActual >= minPrecio && e->precioActual <= maxPrecio)
-                resultado.push_back(e);
-        }
+        for (auto it = indicePrecio.lower_bound({minPrecio, nullptr});
+             it != indicePrecio.end() && it->first <= maxPrecio; ++it)
+            resultado.push_back(it->second);
+        sort(resultado.begin(), resultado.end(), [](const Empresa* a, const Empresa* b) { return a->ticker < b->ticker; });
         return resultado;
     }
 
@@ -565,18 +1957,12 @@ public:
      * @param impacto Impacto de la noticia (1-10).
      */
     void ajustarPreciosPorNoticia(const string& sector, int impacto) {
-        vector<Empresa*> empresas = obtenerEmpresasOrdenadas();
-        float porcentaje = 0.0;
-        if (impacto > 5) {
-            porcentaje = (impacto - 5) * 0.01;
-        } else {
-            porcentaje = -(6 - impacto) * 0.01;
-        }
+        const vector<Empresa*>& empresas = obtenerEmpresasPorSector(sector);
+        float porcentaje = porcentajePorImpacto(impacto);
         for (auto e : empresas) {
-            if (e->sector == sector) {
-                e->precioActual += e->precioActual * porcentaje;
-                if (e->precioActual < 1.0) e->precioActual = 1.0;
-            }
+            float nuevoPrecio = e->precioActual + e->precioActual * porcentaje;
+            if (nuevoPrecio < 1.0) nuevoPrecio = 1.0;
+            fijarPrecio(e, nuevoPrecio);
         }
     }
 
@@ -587,22 +1973,135 @@ public:
      * @param impacto Impacto de la noticia (1-10).
      * @param fecha Fecha de la noticia.
      */
-    void ajustarPreciosPorNoticia(const string& sector, int impacto, const string& fecha) {
-        vector<Empresa*> empresas = obtenerEmpresasOrdenadas();
-        float porcentaje = 0.0;
-        if (impacto > 5) {
-            porcentaje = (impacto - 5) * 0.01;
-        } else {
-            porcentaje = -(6 - impacto) * 0.01;
-        }
+    void ajustarPreciosPorNoticia(const string& sector, int impacto, Fecha fecha) {
+        const vector<Empresa*>& empresas = obtenerEmpresasPorSector(sector);
+        float porcentaje = porcentajePorImpacto(impacto);
         for (auto e : empresas) {
-            if (e->sector == sector) {
-                float nuevoPrecio = e->precioActual + e->precioActual * porcentaje;
-                if (nuevoPrecio < 1.0) nuevoPrecio = 1.0;
-                e->precioActual = nuevoPrecio;
-                e->historialPrecios.agregarPrecio(fecha, nuevoPrecio);
+            float nuevoPrecio = e->precioActual + e->precioActual * porcentaje;
+            if (nuevoPrecio < 1.0) nuevoPrecio = 1.0;
+            fijarPrecio(e, nuevoPrecio);
+            e->historialPrecios.agregarPrecio(fecha, nuevoPrecio);
+        }
+    }
+
+    /**
+     * @brief Aplica un lote de noticias en una sola pasada por empresa afectada.
+     *
+     * El resultado (precios e historiales) es idéntico al de llamar a
+     * ajustarPreciosPorNoticia(sector, impacto, fecha) con cada noticia en orden:
+     * las noticias se agrupan por sector conservando su orden y cada empresa
+     * recorre su cadena de ajustes de una vez. Los índices por precio y los
+     * agregados del sector se actualizan una sola vez por empresa.
+     *
+     * Con varios hilos, las empresas afectadas se reparten en tramos de trabajo
+     * similar. Cada empresa depende solo de su propia cadena, así que el
+     * resultado no depende del número de hilos; los índices compartidos se
+     * actualizan al final, en el hilo que llama.
+     * @param ajustes Noticias a aplicar, en orden cronológico de aplicación.
+     * @param hilos Número de hilos de trabajo (1 = sin hilos adicionales).
+     */
+    void ajustarPreciosPorNoticias(const vector<AjusteNoticia>& ajustes, unsigned hilos = 1) {
+        vector<vector<pair<float, Fecha>>> porSector = cadenasPorSector(ajustes);
+        // Empresas afectadas con la cadena de su sector; el peso es la longitud de la cadena
+        vector<pair<Empresa*, const vector<pair<float, Fecha>>*>> tareas;
+        vector<size_t> pesos;
+        for (size_t id = 0; id < porSector.size(); ++id) {
+            if (porSector[id].empty()) continue;
+            for (Empresa* e : empresasPorSector[id]) {
+                tareas.push_back({e, &porSector[id]});
+                pesos.push_back(porSector[id].size());
             }
         }
+        if (tareas.empty()) return;
+        if (hilos == 0) hilos = 1;
+        if (hilos > tareas.size()) hilos = tareas.size();
+        // Cada hilo reserva bloques de historial en su propio pool
+        prepararPoolsHilos(hilos);
+
+        vector<float> preciosFinales(tareas.size());
+        vector<size_t> cortes = repartirPorPeso(pesos, hilos);
+        ejecutarEnParalelo(hilos, [&](unsigned h) {
+            PoolNodos<BloqueHistorial>* pool = poolDeHilo(h);
+            for (size_t t = cortes[h]; t < cortes[h + 1]; ++t)
+                preciosFinales[t] = aplicarCadena(tareas[t].first, tareas[t].first->precioActual, *tareas[t].second, pool);
+        });
+        for (size_t t = 0; t < tareas.size(); ++t) fijarPrecio(tareas[t].first, preciosFinales[t]);
+    }
+
+    /**
+     * @brief Simula días hábiles de mercado con un grupo de hilos persistente.
+     *
+     * Cada día, cada empresa da un paso del movimiento browniano geométrico de
+     * su sector (un registro con la fecha del día) y luego aplica en orden las
+     * noticias de su sector de ese día, igual que ajustarPreciosPorNoticias.
+     * Las empresas se reparten entre los hilos por rangos de ticker y cada día
+     * termina en una barrera, así que al pedir las noticias del día siguiente
+     * todos los precios actuales ya son los del día. Cada hilo solo escribe en
+     * sus empresas; los índices compartidos (orden por precio y agregados por
+     * sector) se ponen al día una sola vez, al terminar la simulación, en el
+     * hilo que llama. La empresa i (en orden de ticker) usa el flujo
+     * aleatorio (semilla ^ hashTexto("simulacion"), i) durante toda la
+     * simulación, así que el resultado es idéntico bit a bit con cualquier
+     * número de hilos y no repite los choques con los que generarMercado
+     * construyó el historial con la misma semilla.
+     * @param desde Primer día (si no es hábil, el lunes siguiente).
+     * @param dias Días hábiles a simular.
+     * @param semilla Semilla de la simulación.
+     * @param grupo Hilos de trabajo, reutilizados todos los días.
+     * @param noticiasDelDia Si no es nulo, se llama en el hilo que llama con la
+     *        fecha de cada día y un lote vacío que puede llenar.
+     * @param sectores Deriva y volatilidad por sector, en el orden de SECTORES_EMPRESA
+     *        (las empresas de otros sectores solo cambian con las noticias).
+     */
+    void simularDias(Fecha desde, int dias, uint64_t semilla, GrupoHilos& grupo,
+                     const function<void(Fecha, vector<AjusteNoticia>&)>& noticiasDelDia = nullptr,
+                     const vector<ParametrosSector>& sectores = PARAMETROS_SECTORES) {
+        vector<Empresa*> empresas = obtenerEmpresasOrdenadas();
+        const size_t n = empresas.size();
+        if (n == 0 || dias <= 0) return;
+        const unsigned hilos = grupo.tamano();
+        prepararPoolsHilos(hilos);
+
+        // Paso diario de cada empresa (tendencia y escala del browniano) y su flujo aleatorio
+        const double dt = 1.0 / 252;  // Días hábiles por año
+        vector<pair<double, double>> pasos(n, {0.0, 0.0});
+        vector<GeneradorAleatorio> flujos(n);
+        const uint64_t semillaSimulacion = semilla ^ hashTexto("simulacion");
+        for (size_t i = 0; i < n; ++i) {
+            flujos[i] = GeneradorAleatorio(semillaSimulacion, i);
+            if (empresas[i]->sectorId < 0 || (size_t)empresas[i]->sectorId >= sectores.size()) continue;
+            const ParametrosSector& p = sectores[empresas[i]->sectorId];
+            pasos[i] = {(p.deriva - 0.5 * p.volatilidad * p.volatilidad) * dt, p.volatilidad * sqrt(dt)};
+        }
+
+        vector<float> preciosIniciales(n);
+        for (size_t i = 0; i < n; ++i) preciosIniciales[i] = empresas[i]->precioActual;
+        vector<AjusteNoticia> lote;
+        const int32_t primerDia = desde.indiceHabil();
+        for (int d = 0; d < dias; ++d) {
+            const Fecha dia = Fecha::desdeIndiceHabil(primerDia + d);
+            lote.clear();
+            if (noticiasDelDia) noticiasDelDia(dia, lote);
+            vector<vector<pair<float, Fecha>>> porSector = cadenasPorSector(lote);
+            grupo.ejecutar([&](unsigned h) {
+                PoolNodos<BloqueHistorial>* pool = poolDeHilo(h);
+                for (size_t i = n * h / hilos; i < n * (h + 1) / hilos; ++i) {
+                    Empresa* e = empresas[i];
+                    double paso = e->precioActual * exp(pasos[i].first + pasos[i].second * flujos[i].normal());
+                    float precio = max(1.0f, (float)paso);
+                    e->historialPrecios.agregarPrecio(dia, precio, pool);
+                    if (e->sectorId >= 0 && (size_t)e->sectorId < porSector.size())
+                        precio = aplicarCadena(e, precio, porSector[e->sectorId], pool);
+                    e->precioActual = precio;
+                }
+            });
+        }
+        // Los índices compartidos todavía tienen los precios iniciales: se actualizan de una vez
+        for (size_t i = 0; i < n; ++i) {
+            float precioFinal = empresas[i]->precioActual;
+            empresas[i]->precioActual = preciosIniciales[i];
+            fijarPrecio(empresas[i], precioFinal);
+        }
     }
 };
 
@@ -0,0 +1,342 @@
+#ifndef ESTADISTICA_H
+#define ESTADISTICA_H
+
+#include <cmath>
+#include <cstddef>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ESTADISTICA_X86 1
+#endif
+using namespace std;
+
+// ===============================
+// Núcleos vectorizados sobre series de precios (float)
+// ===============================
+//
+// Cada operación tiene una versión escalar portable y, en x86, versiones SSE2
+// y AVX2. La versión se elige una sola vez en tiempo de ejecución según la CPU
+// (ver kernelsSerie()). Las sumas se acumulan en double para no perder
+// precisión con series largas.
+
+/**
+ * @brief Tabla de funciones de la implementación elegida para la CPU actual.
+ */
+struct KernelsSerie {
+    /// Nombre de la implementación ("escalar", "sse2" o "avx2")
+    const char* nombre;
+    /// Suma de n valores
+    double (*suma)(const float* datos, size_t n);
+    /// Suma de (x - media)^2 de n valores
+    double (*sumaCuadradosDesviacion)(const float* datos, size_t n, double media);
+    /// Mínimo y máximo de n valores (n > 0)
+    void (*minMax)(const float* datos, size_t n, float& minimo, float& maximo);
+    /// Producto punto de dos series de n valores
+    double (*productoPunto)(const float* a, const float* b, size_t n);
+    /// Cocientes p[i + 1] / p[i] para i en [0, n - 1)
+    void (*cocientes)(const float* precios, size_t n, float* salida);
+};
+
+// ---------- Versión escalar ----------
+
+inline double sumaEscalar(const float* datos, size_t n) {
+    double suma = 0;
+    for (size_t i = 0; i < n; ++i) suma += datos[i];
+    return suma;
+}
+
+inline double sumaCuadradosDesviacionEscalar(const float* datos, size_t n, double media) {
+    double suma = 0;
+    for (size_t i = 0; i < n; ++i) {
+        double d = datos[i] - media;
+        suma += d * d;
+    }
+    return suma;
+}
+
+inline void minMaxEscalar(const float* datos, size_t n, float& minimo, float& maximo) {
+    minimo = maximo = datos[0];
+    for (size_t i = 1; i < n; ++i) {
+        if (datos[i] < minimo) minimo = datos[i];
+        if (datos[i] > maximo) maximo = datos[i];
+    }
+}
+
+inline double productoPuntoEscalar(const float* a, const float* b, size_t n) {
+    double suma = 0;
+    for (size_t i = 0; i < n; ++i) suma += (double)a[i] * b[i];
+    return suma;
+}
+
+inline void cocientesEscalar(const float* precios, size_t n, float* salida) {
+    for (size_t i = 0; i + 1 < n; ++i) salida[i] = precios[i + 1] / precios[i];
+}
+
+#ifdef ESTADISTICA_X86
+
+// ---------- Versión SSE2 (2 dobles / 4 floats por instrucción) ----------
+
+__attribute__((target("sse2"))) inline double sumaSSE2(const float* datos, size_t n) {
+    __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(datos + i);
+        acc0 = _mm_add_pd(acc0, _mm_cvtps_pd(v));
+        acc1 = _mm_add_pd(acc1, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    double parcial[2];
+    _mm_storeu_pd(parcial, _mm_add_pd(acc0, acc1));
+    return parcial[0] + parcial[1] + sumaEscalar(datos + i, n - i);
+}
+
+__attribute__((target("sse2"))) inline double sumaCuadradosDesviacionSSE2(const float* datos, size_t n, double media) {
+    __m128d m = _mm_set1_pd(media);
+    __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(datos + i);
+        __m128d d0 = _mm_sub_pd(_mm_cvtps_pd(v), m);
+        __m128d d1 = _mm_sub_pd(_mm_cvtps_pd(_mm_movehl_ps(v, v)), m);
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(d0, d0));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(d1, d1));
+    }
+    double parcial[2];
+    _mm_storeu_pd(parcial, _mm_add_pd(acc0, acc1));
+    return parcial[0] + parcial[1] + sumaCuadradosDesviacionEscalar(datos + i, n - i, media);
+}
+
+__attribute__((target("sse2"))) inline void minMaxSSE2(const float* datos, size_t n, float& minimo, float& maximo) {
+    if (n < 4) {
+        minMaxEscalar(datos, n, minimo, maximo);
+        return;
+    }
+    __m128 vmin = _mm_loadu_ps(datos), vmax = vmin;
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(datos + i);
+        vmin = _mm_min_ps(vmin, v);
+        vmax = _mm_max_ps(vmax, v);
+    }
+    float mins[4], maxs[4];
+    _mm_storeu_ps(mins, vmin);
+    _mm_storeu_ps(maxs, vmax);
+    minimo = mins[0];
+    maximo = maxs[0];
+    for (int k = 1; k < 4; ++k) {
+        if (mins[k] < minimo) minimo = mins[k];
+        if (maxs[k] > maximo) maximo = maxs[k];
+    }
+    for (; i < n; ++i) {
+        if (datos[i] < minimo) minimo = datos[i];
+        if (datos[i] > maximo) maximo = datos[i];
+    }
+}
+
+__attribute__((target("sse2"))) inline double productoPuntoSSE2(const float* a, const float* b, size_t n) {
+    __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 va = _mm_loadu_ps(a + i), vb = _mm_loadu_ps(b + i);
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_cvtps_pd(va), _mm_cvtps_pd(vb)));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(va, va)), _mm_cvtps_pd(_mm_movehl_ps(vb, vb))));
+    }
+    double parcial[2];
+    _mm_storeu_pd(parcial, _mm_add_pd(acc0, acc1));
+    return parcial[0] + parcial[1] + productoPuntoEscalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("sse2"))) inline void cocientesSSE2(const float* precios, size_t n, float* salida) {
+    size_t i = 0;
+    for (; i + 5 <= n; i += 4)
+        _mm_storeu_ps(salida + i, _mm_div_ps(_mm_loadu_ps(precios + i + 1), _mm_loadu_ps(precios + i)));
+    cocientesEscalar(precios + i, n - i, salida + i);
+}
+
+// ---------- Versión AVX2 (4 dobles / 8 floats por instrucción) ----------
+
+__attribute__((target("avx2"))) inline double sumaAVX2(const float* datos, size_t n) {
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(datos + i);
+        acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+        acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    }
+    double parcial[4];
+    _mm256_storeu_pd(parcial, _mm256_add_pd(acc0, acc1));
+    return (parcial[0] + parcial[1]) + (parcial[2] + parcial[3]) + sumaEscalar(datos + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline double sumaCuadradosDesviacionAVX2(const float* datos, size_t n, double media) {
+    __m256d m = _mm256_set1_pd(media);
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(datos + i);
+        __m256d d0 = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(v)), m);
+        __m256d d1 = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)), m);
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(d0, d0));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(d1, d1));
+    }
+    double parcial[4];
+    _mm256_storeu_pd(parcial, _mm256_add_pd(acc0, acc1));
+    return (parcial[0] + parcial[1]) + (parcial[2] + parcial[3]) + sumaCuadradosDesviacionEscalar(datos + i, n - i, media);
+}
+
+__attribute__((target("avx2"))) inline void minMaxAVX2(const float* datos, size_t n, float& minimo, float& maximo) {
+    if (n < 8) {
+        minMaxEscalar(datos, n, minimo, maximo);
+        return;
+    }
+    __m256 vmin = _mm256_loadu_ps(datos), vmax = vmin;
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(datos + i);
+        vmin = _mm256_min_ps(vmin, v);
+        vmax = _mm256_max_ps(vmax, v);
+    }
+    float mins[8], maxs[8];
+    _mm256_storeu_ps(mins, vmin);
+    _mm256_storeu_ps(maxs, vmax);
+    minimo = mins[0];
+    maximo = maxs[0];
+    for (int k = 1; k < 8; ++k) {
+        if (mins[k] < minimo) minimo = mins[k];
+        if (maxs[k] > maximo) maximo = maxs[k];
+    }
+    for (; i < n; ++i) {
+        if (datos[i] < minimo) minimo = datos[i];
+        if (datos[i] > maximo) maximo = datos[i];
+    }
+}
+
+__attribute__((target("avx2"))) inline double productoPuntoAVX2(const float* a, const float* b, size_t n) {
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 va = _mm256_loadu_ps(a + i), vb = _mm256_loadu_ps(b + i);
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(va)),
+                                                 _mm256_cvtps_pd(_mm256_castps256_ps128(vb))));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(va, 1)),
+                                                 _mm256_cvtps_pd(_mm256_extractf128_ps(vb, 1))));
+    }
+    double parcial[4];
+    _mm256_storeu_pd(parcial, _mm256_add_pd(acc0, acc1));
+    return (parcial[0] + parcial[1]) + (parcial[2] + parcial[3]) + productoPuntoEscalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline void cocientesAVX2(const float* precios, size_t n, float* salida) {
+    size_t i = 0;
+    for (; i + 9 <= n; i += 8)
+        _mm256_storeu_ps(salida + i, _mm256_div_ps(_mm256_loadu_ps(precios + i + 1), _mm256_loadu_ps(precios + i)));
+    cocientesEscalar(precios + i, n - i, salida + i);
+}
+
+#endif
+
+/**
+ * @brief Implementación escalar (disponible en cualquier plataforma).
+ * @return Tabla de funciones escalares.
+ */
+inline const KernelsSerie& kernelsEscalares() {
+    static const KernelsSerie k = {"escalar", sumaEscalar, sumaCuadradosDesviacionEscalar, minMaxEscalar,
+                                   productoPuntoEscalar, cocientesEscalar};
+    return k;
+}
+
+/**
+ * @brief Implementación elegida para la CPU actual (AVX2, SSE2 o escalar).
+ *
+ * La detección se hace una sola vez, en la primera llamada.
+ * @return Tabla de funciones a usar.
+ */
+inline const KernelsSerie& kernelsSerie() {
+#ifdef ESTADISTICA_X86
+    static const KernelsSerie sse2 = {"sse2", sumaSSE2, sumaCuadradosDesviacionSSE2, minMaxSSE2,
+                                      productoPuntoSSE2, cocientesSSE2};
+    static const KernelsSerie avx2 = {"avx2", sumaAVX2, sumaCuadradosDesviacionAVX2, minMaxAVX2,
+                                      productoPuntoAVX2, cocientesAVX2};
+    static const KernelsSerie* elegida = __builtin_cpu_supports("avx2") ? &avx2
+                                         : __builtin_cpu_supports("sse2") ? &sse2
+                                                                          : &kernelsEscalares();
+    return *elegida;
+#else
+    return kernelsEscalares();
+#endif
+}
+
+// ---------- Funciones de uso general ----------
+
+/**
+ * @brief Suma de una serie de precios.
+ * @param datos Serie de precios.
+ * @param n Número de valores.
+ * @return Suma (en double).
+ */
+inline double sumaSerie(const float* datos, size_t n) {
+    return kernelsSerie().suma(datos, n);
+}
+
+/**
+ * @brief Media de una serie de precios.
+ * @param datos Serie de precios.
+ * @param n Número de valores.
+ * @return Media, o 0 si la serie está vacía.
+ */
+inline double mediaSerie(const float* datos, size_t n) {
+    return n > 0 ? sumaSerie(datos, n) / n : 0;
+}
+
+/**
+ * @brief Varianza poblacional de una serie (dos pasadas: media y desviaciones).
+ * @param datos Serie de precios.
+ * @param n Número de valores.
+ * @return Varianza, o 0 si la serie está vacía.
+ */
+inline double varianzaSerie(const float* datos, size_t n) {
+    if (n == 0) return 0;
+    const KernelsSerie& k = kernelsSerie();
+    double media = k.suma(datos, n) / n;
+    return k.sumaCuadradosDesviacion(datos, n, media) / n;
+}
+
+/**
+ * @brief Mínimo y máximo de una serie.
+ * @param datos Serie de precios.
+ * @param n Número de valores.
+ * @param minimo Mínimo (salida; 0 si la serie está vacía).
+ * @param maximo Máximo (salida; 0 si la serie está vacía).
+ */
+inline void minMaxSerie(const float* datos, size_t n, float& minimo, float& maximo) {
+    if (n == 0) {
+        minimo = maximo = 0;
+        return;
+    }
+    kernelsSerie().minMax(datos, n, minimo, maximo);
+}
+
+/**
+ * @brief Producto punto de dos series.
+ * @param a Primera serie.
+ * @param b Segunda serie.
+ * @param n Número de valores de cada serie.
+ * @return Producto punto (en double).
+ */
+inline double productoPuntoSerie(const float* a, const float* b, size_t n) {
+    return kernelsSerie().productoPunto(a, b, n);
+}
+
+/**
+ * @brief Retornos logarítmicos log(p[i + 1] / p[i]) de una serie de precios.
+ *
+ * Los cocientes se calculan vectorizados; el logaritmo se aplica después con logf.
+ * @param precios Serie de precios (positivos).
+ * @param n Número de precios.
+ * @param salida Arreglo de al menos n - 1 valores.
+ */
+inline void logRetornosSerie(const float* precios, size_t n, float* salida) {
+    if (n < 2) return;
+    kernelsSerie().cocientes(precios, n, salida);
+    for (size_t i = 0; i + 1 < n; ++i) salida[i] = logf(salida[i]);
+}
+
+#endif
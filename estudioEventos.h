@@ -0,0 +1,349 @@
+#ifndef ESTUDIOEVENTOS_H
+#define ESTUDIOEVENTOS_H
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "empresa.h"
+#include "estadistica.h"
+#include "noticia.h"
+#include "paralelo.h"
+using namespace std;
+
+/**
+ * @brief Ventanas de un estudio de eventos, en días de mercado relativos a la noticia.
+ *
+ * El día 0 es la primera fecha del historial igual o posterior a
+ * la de la noticia. La ventana de estimación son los 'estimacion' retornos
+ * inmediatamente anteriores a la ventana del evento [inicio, fin].
+ */
+struct ConfiguracionEstudio {
+    int inicio = -5;      ///< Primer día de la ventana del evento
+    int fin = 10;         ///< Último día de la ventana del evento
+    int estimacion = 60;  ///< Retornos de la ventana de estimación
+
+    /// @brief Días de la ventana del evento.
+    int longitud() const { return fin - inicio + 1; }
+    /// @brief true si las ventanas tienen sentido.
+    bool valida() const { return fin >= inicio && estimacion >= 2; }
+};
+
+/**
+ * @brief Acumulado de los eventos (noticia, empresa) de un grupo.
+ *
+ * Modelo de media constante: el retorno normal de cada evento es la media de
+ * los retornos logarítmicos de su ventana de estimación, y el retorno anormal
+ * (AR) de un día es el retorno observado menos esa media. CAR es la suma de
+ * los AR de la ventana del evento y SCAR el CAR dividido por su desviación
+ * estimada (sigma · raíz de la longitud).
+ */
+struct ResumenEventos {
+    size_t eventos = 0;       ///< Eventos medidos
+    size_t positivos = 0;     ///< Eventos con CAR > 0
+    double sumaCAR = 0;       ///< Suma de los CAR
+    double sumaCAR2 = 0;      ///< Suma de los cuadrados de los CAR
+    double sumaSCAR = 0;      ///< Suma de los CAR estandarizados
+    vector<double> sumaAR;    ///< Suma de los AR de cada día de la ventana del evento
+
+    /// @brief Suma otro resumen de la misma ventana a este.
+    void agregar(const ResumenEventos& otro) {
+        if (sumaAR.size() < otro.sumaAR.size()) sumaAR.resize(otro.sumaAR.size(), 0);
+        for (size_t d = 0; d < otro.sumaAR.size(); ++d) sumaAR[d] += otro.sumaAR[d];
+        eventos += otro.eventos;
+        positivos += otro.positivos;
+        sumaCAR += otro.sumaCAR;
+        sumaCAR2 += otro.sumaCAR2;
+        sumaSCAR += otro.sumaSCAR;
+    }
+
+    /// @brief Retorno anormal promedio (AAR) del día d de la ventana (0 = inicio).
+    double aar(size_t d) const { return eventos > 0 && d < sumaAR.size() ? sumaAR[d] / eventos : 0; }
+    /// @brief CAR promedio (CAAR).
+    double caar() const { return eventos > 0 ? sumaCAR / eventos : 0; }
+    /// @brief Estadístico t de corte transversal del CAAR (0 con menos de dos eventos).
+    double tCAR() const {
+        if (eventos < 2) return 0;
+        double media = caar();
+        double varianza = (sumaCAR2 - eventos * media * media) / (eventos - 1);
+        return varianza > 0 ? media / sqrt(varianza / eventos) : 0;
+    }
+    /// @brief Estadístico Z de los CAR estandarizados: suma de SCAR / raíz de n.
+    double zSCAR() const { return eventos > 0 ? sumaSCAR / sqrt((double)eventos) : 0; }
+    /// @brief Porcentaje de eventos con CAR positivo.
+    double porcentajePositivos() const { return eventos > 0 ? 100.0 * positivos / eventos : 0; }
+};
+
+/**
+ * @brief Eventos de un sector, un nivel de impacto y un signo de noticia.
+ */
+struct GrupoEventos {
+    string sector;            ///< Sector de las noticias
+    int impacto;              ///< Nivel de impacto (1-10)
+    bool esPositiva;          ///< Signo de las noticias
+    ResumenEventos resumen;   ///< Acumulado del grupo
+};
+
+/**
+ * @brief Resultado de un estudio de eventos.
+ */
+struct ResultadoEstudio {
+    ConfiguracionEstudio config;   ///< Ventanas usadas
+    vector<GrupoEventos> grupos;   ///< Grupos (sector, impacto, signo) con eventos medidos
+    size_t noticias = 0;           ///< Noticias estudiadas
+    size_t noticiasSinEmpresas = 0;///< Noticias de sectores sin empresas
+    size_t omitidos = 0;           ///< Pares (noticia, empresa) sin historial suficiente alrededor de la fecha
+    double segundos = 0;           ///< Tiempo del estudio
+
+    /**
+     * @brief Combina los grupos según una clave (por ejemplo, solo el sector).
+     * @param clave Función que recibe un GrupoEventos y devuelve la clave de agrupación.
+     * @return Resumen por clave, en orden de clave.
+     */
+    template <typename F>
+    auto agrupar(F clave) const -> map<decltype(clave(grupos[0])), ResumenEventos> {
+        map<decltype(clave(grupos[0])), ResumenEventos> salida;
+        for (const GrupoEventos& g : grupos) salida[clave(g)].agregar(g.resumen);
+        return salida;
+    }
+
+    /// @brief Resumen de todos los eventos.
+    ResumenEventos total() const {
+        ResumenEventos suma;
+        for (const GrupoEventos& g : grupos) suma.agregar(g.resumen);
+        return suma;
+    }
+
+    /// @brief Eventos medidos en total.
+    size_t eventos() const {
+        size_t n = 0;
+        for (const GrupoEventos& g : grupos) n += g.resumen.eventos;
+        return n;
+    }
+};
+
+/**
+ * @brief Estudio de eventos de las noticias de la cola sobre las empresas de su sector.
+ *
+ * Cada noticia se cruza con todas las empresas de su sector. El trabajo se
+ * reparte por empresas: cada una lee una vez sus cierres en orden de fecha
+ * (un precio por fecha: el último registro de ese día), calcula sus retornos
+ * logarítmicos y sus sumas acumuladas, y recorre las noticias de su sector
+ * (ya ordenadas por fecha) avanzando un solo puntero,
+ * así que cada evento cuesta O(longitud de la ventana) y cada empresa
+ * O(h + noticias del sector). Los hilos toman tramos fijos de empresas y los
+ * tramos se suman al final en orden, de modo que el resultado no depende del
+ * número de hilos. Los historiales solo se leen.
+ * @param arbol Árbol de empresas.
+ * @param cola Cola de noticias.
+ * @param config Ventanas del estudio.
+ * @param hilos Número de hilos de trabajo.
+ * @return Resumen por sector, impacto y signo de la noticia.
+ */
+inline ResultadoEstudio estudioDeEventos(const ABBEmpresas& arbol, const ColaPrioridadNoticias& cola,
+                                               const ConfiguracionEstudio& config, unsigned hilos = hilosDisponibles()) {
+    const int GRUPOS_POR_SECTOR = 20;  // Impacto 1-10 x signo
+    const size_t EMPRESAS_POR_TRAMO = 16;
+    auto inicioEstudio = chrono::steady_clock::now();
+    ResultadoEstudio resultado;
+    resultado.config = config;
+    if (!config.valida()) return resultado;
+
+    /// Noticias de un sector con empresas, ordenadas por fecha
+    struct SectorEstudio {
+        string nombre;
+        const vector<Empresa*>* empresas;
+        vector<pair<Fecha, int>> eventos;  ///< Fecha y grupo dentro del sector
+    };
+    vector<SectorEstudio> sectores;
+    unordered_map<const char*, int> sectorDeTexto;  // Sector internado -> posición (-1 sin empresas)
+    unordered_map<const vector<Empresa*>*, int> sectorDeLista;
+    vector<Noticia*> noticias;
+    cola.obtenerNoticias(noticias);
+    resultado.noticias = noticias.size();
+    for (const Noticia* n : noticias) {
+        auto it = sectorDeTexto.find(n->sectorAfectado.data());
+        if (it == sectorDeTexto.end()) {
+            const vector<Empresa*>* empresas = &arbol.obtenerEmpresasPorSector(string(n->sectorAfectado));
+            int posicion = -1;
+            if (!empresas->empty()) {
+                auto jt = sectorDeLista.find(empresas);
+                if (jt == sectorDeLista.end()) {
+                    jt = sectorDeLista.emplace(empresas, (int)sectores.size()).first;
+                    sectores.push_back({string(n->sectorAfectado), empresas, {}});
+                }
+                posicion = jt->second;
+            }
+            it = sectorDeTexto.emplace(n->sectorAfectado.data(), posicion).first;
+        }
+        if (it->second < 0) {
+            resultado.noticiasSinEmpresas++;
+            continue;
+        }
+        int impacto = min(max(n->impacto, 1), 10);  // Fuera de 1-10 se agrupa en el extremo
+        sectores[it->second].eventos.push_back({n->fecha, (impacto - 1) * 2 + (n->esPositiva ? 1 : 0)});
+    }
+
+    // Tramos fijos de empresas de un mismo sector, cada uno con sus acumulados
+    struct Tramo {
+        int sector;
+        size_t desde, hasta;
+        vector<ResumenEventos> grupos;
+        size_t omitidos = 0;
+    };
+    vector<Tramo> tramos;
+    for (size_t s = 0; s < sectores.size(); ++s) {
+        sort(sectores[s].eventos.begin(), sectores[s].eventos.end(),
+             [](const pair<Fecha, int>& a, const pair<Fecha, int>& b) { return a.first < b.first; });
+        size_t total = sectores[s].empresas->size();
+        for (size_t desde = 0; desde < total; desde += EMPRESAS_POR_TRAMO) {
+            tramos.push_back({(int)s, desde, min(desde + EMPRESAS_POR_TRAMO, total), {}, 0});
+        }
+    }
+
+    const int L = config.longitud();
+    const int E = config.estimacion;
+    atomic<size_t> siguiente(0);
+    if (hilos == 0) hilos = 1;
+    if (hilos > tramos.size()) hilos = max<size_t>(tramos.size(), 1);
+    ejecutarEnParalelo(hilos, [&](unsigned) {
+        vector<Fecha> fechas;
+        vector<float> precios, retornos;
+        vector<double> suma, suma2;  // Sumas acumuladas de retornos y de sus cuadrados
+        for (size_t t = siguiente++; t < tramos.size(); t = siguiente++) {
+            Tramo& tramo = tramos[t];
+            const SectorEstudio& sector = sectores[tramo.sector];
+            tramo.grupos.assign(GRUPOS_POR_SECTOR, ResumenEventos());
+            for (ResumenEventos& g : tramo.grupos) g.sumaAR.assign(L, 0);
+            for (size_t i = tramo.desde; i < tramo.hasta; ++i) {
+                (*sector.empresas)[i]->historialPrecios.cierresEnOrdenDeFecha(fechas, precios);
+                size_t n = precios.size();
+                if (n < 2) {
+                    tramo.omitidos += sector.eventos.size();
+                    continue;
+                }
+                // retornos[j] es el retorno del día j (del j - 1 al j); retornos[0] no se usa
+                retornos.resize(n);
+                retornos[0] = 0;
+                logRetornosSerie(precios.data(), n, retornos.data() + 1);
+                suma.resize(n + 1);
+                suma2.resize(n + 1);
+                suma[0] = suma2[0] = 0;
+                for (size_t j = 0; j < n; ++j) {
+                    suma[j + 1] = suma[j] + retornos[j];
+                    suma2[j + 1] = suma2[j] + (double)retornos[j] * retornos[j];
+                }
+                // suma[b] - suma[a] = retornos de los días [a, b)
+                size_t dia0 = 0;
+                for (const pair<Fecha, int>& evento : sector.eventos) {
+                    while (dia0 < n && fechas[dia0] < evento.first) dia0++;
+                    long long primeroEstimacion = (long long)dia0 + config.inicio - E;
+                    long long ultimoEvento = (long long)dia0 + config.fin;
+                    if (dia0 == n || primeroEstimacion < 1 || ultimoEvento >= (long long)n) {
+                        tramo.omitidos++;
+                        continue;
+                    }
+                    size_t a = primeroEstimacion, b = dia0 + config.inicio;  // Estimación: [a, b)
+                    double media = (suma[b] - suma[a]) / E;
+                    double varianza = (suma2[b] - suma2[a] - E * media * media) / (E - 1);
+                    if (!(varianza > 0)) {  // Precio constante: no hay con qué comparar
+                        tramo.omitidos++;
+                        continue;
+                    }
+                    double car = suma[b + L] - suma[b] - L * media;
+                    ResumenEventos& g = tramo.grupos[evento.second];
+                    const float* ventana = retornos.data() + b;
+                    for (int d = 0; d < L; ++d) g.sumaAR[d] += ventana[d] - media;
+                    g.eventos++;
+                    if (car > 0) g.positivos++;
+                    g.sumaCAR += car;
+                    g.sumaCAR2 += car * car;
+                    g.sumaSCAR += car / sqrt(varianza * L);
+                }
+            }
+        }
+    });
+
+    // Suma de los tramos en orden fijo
+    vector<vector<ResumenEventos>> porSector(sectores.size(), vector<ResumenEventos>(GRUPOS_POR_SECTOR));
+    for (const Tramo& tramo : tramos) {
+        resultado.omitidos += tramo.omitidos;
+        for (int g = 0; g < GRUPOS_POR_SECTOR; ++g) porSector[tramo.sector][g].agregar(tramo.grupos[g]);
+    }
+    for (size_t s = 0; s < sectores.size(); ++s) {
+        for (int g = 0; g < GRUPOS_POR_SECTOR; ++g) {
+            if (porSector[s][g].eventos == 0) continue;
+            resultado.grupos.push_back({sectores[s].nombre, g / 2 + 1, g % 2 == 1, porSector[s][g]});
+        }
+    }
+    resultado.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicioEstudio).count();
+    return resultado;
+}
+
+/**
+ * @brief Muestra una fila de resumen: eventos, CAAR, estadísticos y porcentaje de CAR positivos.
+ * @param etiqueta Nombre de la fila.
+ * @param r Resumen de la fila.
+ */
+inline void mostrarResumenEventos(const string& etiqueta, const ResumenEventos& r) {
+    cout << "  " << left << setw(20) << etiqueta << right << setw(9) << r.eventos << setw(11) << fixed
+         << setprecision(3) << r.caar() * 100 << "%" << setw(9) << setprecision(2) << r.tCAR() << setw(9) << r.zSCAR()
+         << setw(9) << setprecision(1) << r.porcentajePositivos() << "%\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+/**
+ * @brief Muestra el resultado de un estudio de eventos: resúmenes por sector,
+ *        impacto y signo, y la curva de AAR/CAAR de todos los eventos.
+ * @param resultado Resultado de estudioDeEventos.
+ */
+inline void mostrarEstudioDeEventos(const ResultadoEstudio& resultado) {
+    const ConfiguracionEstudio& c = resultado.config;
+    cout << "\n================= ESTUDIO DE EVENTOS =================\n";
+    cout << "Ventana [" << c.inicio << ", " << c.fin << "] días, estimación de " << c.estimacion
+         << " días (modelo de media constante)\n";
+    cout << resultado.noticias << " noticias, " << resultado.eventos() << " eventos (noticia, empresa) medidos, "
+         << resultado.omitidos << " sin historial suficiente";
+    if (resultado.noticiasSinEmpresas > 0) cout << ", " << resultado.noticiasSinEmpresas << " noticias sin empresas";
+    cout << "; " << resultado.segundos << " s\n";
+    if (resultado.grupos.empty()) {
+        cout << "Ningún evento tiene historial suficiente alrededor de su fecha.\n";
+        return;
+    }
+    cout << "\n  " << left << setw(20) << "Grupo" << right << setw(9) << "Eventos" << setw(12) << "CAAR"
+         << setw(9) << "t" << setw(9) << "Z" << setw(10) << "CAR>0" << "\n";
+    cout << "  ------------------------------------------------------------------\n";
+    for (const auto& par : resultado.agrupar([](const GrupoEventos& g) { return g.sector; })) {
+        mostrarResumenEventos(par.first, par.second);
+    }
+    cout << "  ------------------------------------------------------------------\n";
+    for (const auto& par : resultado.agrupar([](const GrupoEventos& g) { return g.impacto; })) {
+        mostrarResumenEventos("Impacto " + to_string(par.first), par.second);
+    }
+    cout << "  ------------------------------------------------------------------\n";
+    for (const auto& par : resultado.agrupar([](const GrupoEventos& g) { return g.esPositiva; })) {
+        mostrarResumenEventos(par.first ? "Positivas" : "Negativas", par.second);
+    }
+    ResumenEventos total = resultado.total();
+    cout << "  ------------------------------------------------------------------\n";
+    mostrarResumenEventos("Total", total);
+
+    cout << "\n  Día     AAR        CAAR\n";
+    double caar = 0;
+    for (int d = 0; d < c.longitud(); ++d) {
+        caar += total.aar(d);
+        cout << "  " << setw(4) << c.inicio + d << fixed << setprecision(4) << setw(9) << total.aar(d) * 100 << "%"
+             << setw(10) << caar * 100 << "%\n";
+    }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+    cout << "======================================================\n";
+}
+
+#endif
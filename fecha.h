@@ -0,0 +1,224 @@
+#ifndef FECHA_H
+#define FECHA_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+using namespace std;
+
+/**
+ * @brief Fecha compacta: número de días desde el 1970-01-01 en un entero de 32 bits.
+ *
+ * Comparar dos fechas es comparar dos enteros. La conversión desde y hacia
+ * año/mes/día es O(1) y respeta los años bisiestos del calendario gregoriano.
+ * Incluye un calendario bursátil simple (lunes a viernes, sin festivos).
+ */
+struct Fecha {
+    /// Días transcurridos desde el 1970-01-01 (negativo para fechas anteriores)
+    int32_t dias;
+
+    /// @brief Constructor por defecto (1970-01-01).
+    Fecha() : dias(0) {}
+
+    /**
+     * @brief Construye una fecha a partir de su número de días.
+     * @param d Días desde el 1970-01-01.
+     */
+    explicit Fecha(int32_t d) : dias(d) {}
+
+    /**
+     * @brief Indica si un año es bisiesto.
+     * @param anio Año.
+     * @return true si el año es bisiesto.
+     */
+    static bool esBisiesto(int anio) {
+        return (anio % 4 == 0 && anio % 100 != 0) || anio % 400 == 0;
+    }
+
+    /**
+     * @brief Número de días de un mes.
+     * @param anio Año.
+     * @param mes Mes (1-12).
+     * @return Días del mes.
+     */
+    static int diasDelMes(int anio, int mes) {
+        static const int dias[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return (mes == 2 && esBisiesto(anio)) ? 29 : dias[mes - 1];
+    }
+
+    /**
+     * @brief Construye una fecha desde año, mes y día (sin validar).
+     *
+     * Usa el cálculo por eras de 400 años: el año se cuenta desde marzo para
+     * que el 29 de febrero quede al final.
+     * @param anio Año.
+     * @param mes Mes (1-12).
+     * @param dia Día del mes.
+     * @return Fecha correspondiente.
+     */
+    static Fecha desdeCivil(int anio, int mes, int dia) {
+        anio -= mes <= 2;
+        const int era = (anio >= 0 ? anio : anio - 399) / 400;
+        const int anioEra = anio - era * 400;                                  // [0, 399]
+        const int diaAnio = (153 * (mes + (mes > 2 ? -3 : 9)) + 2) / 5 + dia - 1; // [0, 365]
+        const int diaEra = anioEra * 365 + anioEra / 4 - anioEra / 100 + diaAnio; // [0, 146096]
+        return Fecha(era * 146097 + diaEra - 719468);
+    }
+
+    /**
+     * @brief Convierte la fecha a año, mes y día.
+     * @param anio Año (salida).
+     * @param mes Mes 1-12 (salida).
+     * @param dia Día del mes (salida).
+     */
+    void aCivil(int& anio, int& mes, int& dia) const {
+        const int z = dias + 719468;
+        const int era = (z >= 0 ? z : z - 146096) / 146097;
+        const int diaEra = z - era * 146097;                                              // [0, 146096]
+        const int anioEra = (diaEra - diaEra / 1460 + diaEra / 36524 - diaEra / 146096) / 365; // [0, 399]
+        const int diaAnio = diaEra - (365 * anioEra + anioEra / 4 - anioEra / 100);        // [0, 365]
+        const int mp = (5 * diaAnio + 2) / 153;                                           // [0, 11]
+        dia = diaAnio - (153 * mp + 2) / 5 + 1;
+        mes = mp < 10 ? mp + 3 : mp - 9;
+        anio = anioEra + era * 400 + (mes <= 2);
+    }
+
+    /**
+     * @brief Día de la semana.
+     * @return 0 = lunes, ..., 6 = domingo.
+     */
+    int diaSemana() const {
+        // El 1970-01-01 fue jueves (3)
+        int r = (dias + 3) % 7;
+        return r < 0 ? r + 7 : r;
+    }
+
+    /// @brief Indica si la fecha es día hábil bursátil (lunes a viernes).
+    bool esDiaHabil() const { return diaSemana() < 5; }
+
+    /**
+     * @brief Número de días hábiles desde el lunes 1969-12-29 hasta esta fecha.
+     *
+     * Un sábado o domingo recibe el índice del lunes siguiente. Sirve para
+     * medir ventanas en días de mercado con una resta.
+     * @return Índice de día hábil.
+     */
+    int32_t indiceHabil() const {
+        int32_t desdeLunes = dias + 3;
+        int32_t semanas = (desdeLunes >= 0 ? desdeLunes : desdeLunes - 6) / 7;
+        int32_t dia = desdeLunes - semanas * 7;
+        return semanas * 5 + (dia < 5 ? dia : 5);
+    }
+
+    /**
+     * @brief Fecha del día hábil con el índice dado (inversa de indiceHabil()).
+     * @param indice Índice de día hábil.
+     * @return Fecha correspondiente (siempre de lunes a viernes).
+     */
+    static Fecha desdeIndiceHabil(int32_t indice) {
+        int32_t semanas = (indice >= 0 ? indice : indice - 4) / 5;
+        int32_t dia = indice - semanas * 5;
+        return Fecha(semanas * 7 + dia - 3);
+    }
+
+    /**
+     * @brief Avanza un número de días hábiles en O(1).
+     * @param n Días hábiles a avanzar (puede ser negativo).
+     * @return Fecha resultante; desde un fin de semana se cuenta a partir del lunes siguiente.
+     */
+    Fecha sumarDiasHabiles(int n) const {
+        return desdeIndiceHabil(indiceHabil() + n);
+    }
+
+    /// @brief Siguiente día hábil estrictamente posterior.
+    Fecha siguienteDiaHabil() const {
+        return esDiaHabil() ? sumarDiasHabiles(1) : sumarDiasHabiles(0);
+    }
+
+    /**
+     * @brief Interpreta un texto "AAAA-MM-DD" validando mes y día.
+     * @param texto Inicio del texto (no necesita terminar en '\0').
+     * @param longitud Longitud del texto.
+     * @param salida Fecha leída si el texto es válido.
+     * @return true si el texto es una fecha válida.
+     */
+    static bool parsear(const char* texto, size_t longitud, Fecha& salida) {
+        if (longitud != 10 || texto[4] != '-' || texto[7] != '-') return false;
+        int valores[3] = {0, 0, 0};
+        const int inicio[3] = {0, 5, 8}, largo[3] = {4, 2, 2};
+        for (int c = 0; c < 3; ++c) {
+            for (int k = 0; k < largo[c]; ++k) {
+                char ch = texto[inicio[c] + k];
+                if (ch < '0' || ch > '9') return false;
+                valores[c] = valores[c] * 10 + (ch - '0');
+            }
+        }
+        if (valores[1] < 1 || valores[1] > 12) return false;
+        if (valores[2] < 1 || valores[2] > diasDelMes(valores[0], valores[1])) return false;
+        salida = desdeCivil(valores[0], valores[1], valores[2]);
+        return true;
+    }
+
+    /**
+     * @brief Interpreta un texto "AAAA-MM-DD" validando mes y día.
+     * @param texto Texto a interpretar.
+     * @param salida Fecha leída si el texto es válido.
+     * @return true si el texto es una fecha válida.
+     */
+    static bool parsear(const string& texto, Fecha& salida) {
+        return parsear(texto.data(), texto.size(), salida);
+    }
+
+    /**
+     * @brief Escribe la fecha como "AAAA-MM-DD" (años 0-9999).
+     * @param buffer Arreglo de al menos 11 caracteres; queda terminado en '\0'.
+     */
+    void formatear(char* buffer) const {
+        int anio, mes, dia;
+        aCivil(anio, mes, dia);
+        buffer[0] = '0' + (anio / 1000) % 10;
+        buffer[1] = '0' + (anio / 100) % 10;
+        buffer[2] = '0' + (anio / 10) % 10;
+        buffer[3] = '0' + anio % 10;
+        buffer[4] = '-';
+        buffer[5] = '0' + mes / 10;
+        buffer[6] = '0' + mes % 10;
+        buffer[7] = '-';
+        buffer[8] = '0' + dia / 10;
+        buffer[9] = '0' + dia % 10;
+        buffer[10] = '\0';
+    }
+
+    /// @brief Devuelve la fecha como texto "AAAA-MM-DD".
+    string aTexto() const {
+        char buffer[11];
+        formatear(buffer);
+        return string(buffer, 10);
+    }
+
+    /// @brief Fecha desplazada en días de calendario.
+    Fecha operator+(int n) const { return Fecha(dias + n); }
+    /// @brief Diferencia en días de calendario.
+    int operator-(const Fecha& otra) const { return dias - otra.dias; }
+
+    bool operator==(const Fecha& otra) const { return dias == otra.dias; }
+    bool operator!=(const Fecha& otra) const { return dias != otra.dias; }
+    bool operator<(const Fecha& otra) const { return dias < otra.dias; }
+    bool operator<=(const Fecha& otra) const { return dias <= otra.dias; }
+    bool operator>(const Fecha& otra) const { return dias > otra.dias; }
+    bool operator>=(const Fecha& otra) const { return dias >= otra.dias; }
+};
+
+/**
+ * @brief Imprime una fecha en formato "AAAA-MM-DD".
+ * @param os Flujo de salida.
+ * @param f Fecha a imprimir.
+ * @return El mismo flujo.
+ */
+inline ostream& operator<<(ostream& os, const Fecha& f) {
+    char buffer[11];
+    f.formatear(buffer);
+    return os << buffer;
+}
+
+#endif
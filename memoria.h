@@ -0,0 +1,429 @@
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+/**
+ * @brief Pool (arena) de nodos de un mismo tipo.
+ *
+ * Reserva la memoria en bloques contiguos que crecen al doble hasta un tope
+ * de 1 MiB (así un tipo grande no pide cientos de MiB en una sola reserva),
+ * de modo que crear un nodo es avanzar un índice dentro del bloque actual.
+ * Los bloques se devuelven de una vez con liberarTodo(). Los nodos de tipos
+ * trivialmente destructibles también se pueden liberar uno a uno con
+ * liberar(): su casilla queda en una lista de libres y la reusa el próximo crear().
+ */
+template <typename T>
+class PoolNodos {
+private:
+    /// Tamaño (en nodos) del primer bloque
+    static const size_t BLOQUE_INICIAL = 64;
+    /// Tamaño máximo (en nodos) de un bloque: 1 MiB, o un nodo si T es más grande
+    static constexpr size_t BLOQUE_MAXIMO = max<size_t>(1, (size_t(1) << 20) / sizeof(T));
+
+    /// Bloques reservados, cada uno con su capacidad en nodos
+    vector<pair<T*, size_t>> bloques;
+    /// Nodos ya construidos en el último bloque
+    size_t usadosEnBloque;
+    /// Total de nodos construidos (sin contar los liberados)
+    size_t total;
+    /// Casillas liberadas con liberar(), listas para reusar
+    vector<T*> libres;
+
+    /// @brief Reserva un bloque nuevo del doble del anterior (con tope).
+    void nuevoBloque() {
+        size_t capacidad = bloques.empty() ? BLOQUE_INICIAL : bloques.back().second * 2;
+        if (capacidad > BLOQUE_MAXIMO) capacidad = BLOQUE_MAXIMO;
+        T* memoria = static_cast<T*>(::operator new(capacidad * sizeof(T)));
+        bloques.push_back({memoria, capacidad});
+        usadosEnBloque = 0;
+    }
+
+public:
+    /// @brief Constructor. No reserva memoria hasta el primer nodo.
+    PoolNodos() : usadosEnBloque(0), total(0) {}
+
+    PoolNodos(const PoolNodos&) = delete;
+    PoolNodos& operator=(const PoolNodos&) = delete;
+
+    /// @brief Destructor. Libera todos los nodos.
+    ~PoolNodos() { liberarTodo(); }
+
+    /**
+     * @brief Construye un nodo dentro del pool.
+     * @param args Argumentos para el constructor de T.
+     * @return Puntero al nodo creado (válido hasta liberarTodo()).
+     */
+    template <typename... Args>
+    T* crear(Args&&... args) {
+        T* nodo;
+        if (!libres.empty()) {
+            nodo = libres.back();
+            libres.pop_back();
+        } else {
+            if (bloques.empty() || usadosEnBloque == bloques.back().second) nuevoBloque();
+            nodo = bloques.back().first + usadosEnBloque;
+            usadosEnBloque++;
+        }
+        new (nodo) T(std::forward<Args>(args)...);
+        total++;
+        return nodo;
+    }
+
+    /**
+     * @brief Devuelve un nodo al pool para reusar su casilla. O(1).
+     *
+     * Solo para tipos trivialmente destructibles: liberarTodo() no recorre
+     * los nodos, así que no hay riesgo de destruir dos veces una casilla libre.
+     * @param nodo Nodo creado por este pool.
+     */
+    void liberar(T* nodo) {
+        static_assert(is_trivially_destructible<T>::value, "liberar() requiere un tipo trivialmente destructible");
+        libres.push_back(nodo);
+        total--;
+    }
+
+    /**
+     * @brief Destruye todos los nodos y devuelve los bloques al sistema.
+     *
+     * Si T es trivialmente destructible no se recorren los nodos.
+     */
+    void liberarTodo() {
+        for (size_t b = 0; b < bloques.size(); ++b) {
+            if (!is_trivially_destructible<T>::value) {
+                size_t construidos = (b + 1 == bloques.size()) ? usadosEnBloque : bloques[b].second;
+                for (size_t i = 0; i < construidos; ++i) bloques[b].first[i].~T();
+            }
+            ::operator delete(bloques[b].first);
+        }
+        bloques.clear();
+        libres.clear();
+        usadosEnBloque = 0;
+        total = 0;
+    }
+
+    /// @brief Número de nodos construidos en el pool.
+    size_t cantidad() const { return total; }
+
+    /// @brief Número de bloques reservados (reservas reales de memoria).
+    size_t numBloques() const { return bloques.size(); }
+};
+
+/**
+ * @brief Tabla de textos internados: cada texto distinto se guarda una sola vez.
+ *
+ * internar() devuelve una vista al texto guardado, estable mientras viva la
+ * tabla, de modo que dos textos iguales tienen la misma dirección y se pueden
+ * comparar o usar como clave por puntero. Los textos se copian (terminados en
+ * '\0') en bloques de 64 KiB y no se liberan hasta destruir la tabla.
+ */
+class TablaTextos {
+private:
+    /// Tamaño de un bloque de texto
+    static const size_t BLOQUE = 65536;
+
+    /// Bloques reservados
+    vector<unique_ptr<char[]>> bloques;
+    /// Siguiente byte libre del bloque actual
+    char* libre;
+    /// Bytes libres en el bloque actual
+    size_t disponibles;
+    /// Vistas a los textos guardados
+    unordered_set<string_view> textos;
+    /// Bytes de texto guardados
+    size_t bytes;
+
+    /// @brief Reserva espacio para n bytes (un texto más grande que un bloque recibe el suyo).
+    char* reservar(size_t n) {
+        if (n > BLOQUE / 4) {
+            bloques.emplace_back(new char[n]);
+            return bloques.back().get();
+        }
+        if (n > disponibles) {
+            bloques.emplace_back(new char[BLOQUE]);
+            libre = bloques.back().get();
+            disponibles = BLOQUE;
+        }
+        char* destino = libre;
+        libre += n;
+        disponibles -= n;
+        return destino;
+    }
+
+public:
+    /// @brief Constructor. No reserva memoria hasta el primer texto.
+    TablaTextos() : libre(nullptr), disponibles(0), bytes(0) {}
+
+    TablaTextos(const TablaTextos&) = delete;
+    TablaTextos& operator=(const TablaTextos&) = delete;
+
+    /**
+     * @brief Devuelve la copia guardada de un texto, agregándolo si es nuevo.
+     * @param texto Texto a internar.
+     * @return Vista estable al texto guardado.
+     */
+    string_view internar(string_view texto) {
+        auto it = textos.find(texto);
+        if (it != textos.end()) return *it;
+        // Un byte más para el '\0' final: además, ningún texto (ni el vacío) comparte dirección
+        char* destino = reservar(texto.size() + 1);
+        if (!texto.empty()) memcpy(destino, texto.data(), texto.size());
+        destino[texto.size()] = '\0';
+        string_view copia(destino, texto.size());
+        textos.insert(copia);
+        bytes += texto.size();
+        return copia;
+    }
+
+    /// @brief Número de textos distintos guardados.
+    size_t cantidad() const { return textos.size(); }
+
+    /// @brief Bytes de texto guardados.
+    size_t bytesGuardados() const { return bytes; }
+
+    /**
+     * @brief Intercambia el contenido con otra tabla (para reconstruirla solo con los textos en uso).
+     * @param otra Tabla con la que se intercambia.
+     */
+    void intercambiar(TablaTextos& otra) {
+        bloques.swap(otra.bloques);
+        swap(libre, otra.libre);
+        swap(disponibles, otra.disponibles);
+        textos.swap(otra.textos);
+        swap(bytes, otra.bytes);
+    }
+};
+
+/**
+ * @brief Archivo proyectado en memoria.
+ *
+ * El contenido se lee directamente de la página del sistema operativo, sin
+ * copiarlo a un buffer propio. Con copia privada, el contenido también se puede
+ * modificar: las páginas tocadas se copian y el archivo no cambia. En Windows
+ * se lee el archivo completo.
+ */
+class ArchivoMapeado {
+private:
+    /// Inicio del contenido (nullptr si no se pudo abrir)
+    char* datos;
+    /// Tamaño en bytes
+    size_t bytes;
+    /// Contenido de un archivo vacío
+    char vacio[1];
+#ifdef _WIN32
+    /// Copia del archivo (sin proyección en memoria)
+    string contenido;
+#endif
+
+public:
+    /**
+     * @brief Abre y proyecta un archivo.
+     * @param ruta Ruta del archivo.
+     * @param copiaPrivada true para poder escribir sobre el contenido (sin modificar el archivo).
+     */
+    explicit ArchivoMapeado(const string& ruta, bool copiaPrivada = false) : datos(nullptr), bytes(0), vacio{0} {
+#ifdef _WIN32
+        ifstream archivo(ruta, ios::binary);
+        if (!archivo) return;
+        contenido.assign(istreambuf_iterator<char>(archivo), istreambuf_iterator<char>());
+        datos = &contenido[0];
+        bytes = contenido.size();
+#else
+        int fd = open(ruta.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat info;
+        if (fstat(fd, &info) == 0) {
+            if (info.st_size == 0) {
+                datos = vacio;  // Archivo vacío: abierto, sin contenido
+            } else {
+                int proteccion = copiaPrivada ? PROT_READ | PROT_WRITE : PROT_READ;
+                void* p = mmap(nullptr, info.st_size, proteccion, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED) {
+                    if (!copiaPrivada) madvise(p, info.st_size, MADV_SEQUENTIAL);
+                    datos = static_cast<char*>(p);
+                    bytes = info.st_size;
+                }
+            }
+        }
+        close(fd);
+#endif
+    }
+
+    ArchivoMapeado(const ArchivoMapeado&) = delete;
+    ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+
+    /// @brief Libera la proyección.
+    ~ArchivoMapeado() {
+#ifndef _WIN32
+        if (datos && bytes > 0) munmap(datos, bytes);
+#endif
+    }
+
+    /// @brief Indica si el archivo se abrió correctamente.
+    bool abierto() const { return datos != nullptr; }
+    /// @brief Contenido del archivo.
+    const char* inicio() const { return datos; }
+    /// @brief Contenido del archivo, modificable si se abrió con copia privada.
+    char* inicio() { return datos; }
+    /// @brief Tamaño del archivo en bytes.
+    size_t tamano() const { return bytes; }
+};
+
+/**
+ * @brief Escritura secuencial de un archivo binario con un buffer grande.
+ */
+class EscritorBinario {
+private:
+    /// Archivo de salida (nullptr si no se pudo abrir)
+    FILE* archivo;
+    /// Bytes escritos hasta ahora
+    uint64_t escritos;
+    /// Indica si alguna escritura falló
+    bool error;
+
+public:
+    /**
+     * @brief Abre (o reemplaza) el archivo de salida.
+     * @param ruta Ruta del archivo.
+     */
+    explicit EscritorBinario(const string& ruta) : escritos(0), error(false) {
+        archivo = fopen(ruta.c_str(), "wb");
+        if (archivo) setvbuf(archivo, nullptr, _IOFBF, 1 << 20);
+        else error = true;
+    }
+
+    EscritorBinario(const EscritorBinario&) = delete;
+    EscritorBinario& operator=(const EscritorBinario&) = delete;
+
+    /// @brief Destructor. Cierra el archivo si sigue abierto.
+    ~EscritorBinario() { cerrar(); }
+
+    /**
+     * @brief Escribe bytes al final del archivo.
+     * @param datos Bytes a escribir.
+     * @param n Cantidad de bytes.
+     */
+    void bytes(const void* datos, size_t n) {
+        if (error || n == 0) return;
+        if (fwrite(datos, 1, n, archivo) != n) error = true;
+        escritos += n;
+    }
+
+    /// @brief Escribe un valor de tipo trivial tal como está en memoria.
+    template <typename T>
+    void valor(const T& v) { bytes(&v, sizeof(T)); }
+
+    /// @brief Escribe un texto como longitud (32 bits) seguida de sus caracteres.
+    void texto(string_view s) {
+        valor<uint32_t>(s.size());
+        bytes(s.data(), s.size());
+    }
+
+    /// @brief Bytes escritos hasta ahora.
+    uint64_t posicion() const { return escritos; }
+
+    /**
+     * @brief Cierra el archivo, forzando antes su escritura al disco.
+     * @return true si todas las escrituras se completaron.
+     */
+    bool cerrar() {
+        if (archivo) {
+            if (fflush(archivo) != 0) error = true;
+#ifndef _WIN32
+            if (!error && fsync(fileno(archivo)) != 0) error = true;
+#endif
+            if (fclose(archivo) != 0) error = true;
+            archivo = nullptr;
+        }
+        return !error;
+    }
+};
+
+/**
+ * @brief Lectura con verificación de límites sobre un buffer en memoria.
+ */
+class LectorBinario {
+private:
+    /// Posición actual
+    const char* actual;
+    /// Fin del buffer
+    const char* fin;
+    /// Indica si alguna lectura se salió del buffer
+    bool error;
+
+public:
+    /**
+     * @brief Constructor.
+     * @param datos Inicio del buffer.
+     * @param n Tamaño del buffer.
+     */
+    LectorBinario(const char* datos, size_t n) : actual(datos), fin(datos + n), error(false) {}
+
+    /// @brief Copia un valor de tipo trivial (queda en cero si no hay datos suficientes).
+    template <typename T>
+    T valor() {
+        T v;
+        memset(&v, 0, sizeof(T));
+        if (error || (size_t)(fin - actual) < sizeof(T)) {
+            error = true;
+            return v;
+        }
+        memcpy(&v, actual, sizeof(T));
+        actual += sizeof(T);
+        return v;
+    }
+
+    /// @brief Lee un texto escrito con EscritorBinario::texto.
+    string texto() {
+        uint32_t n = valor<uint32_t>();
+        if (error || (size_t)(fin - actual) < n) {
+            error = true;
+            return string();
+        }
+        string s(actual, n);
+        actual += n;
+        return s;
+    }
+
+    /// @brief Lee un texto sin copiarlo: la vista apunta al archivo proyectado.
+    string_view vistaTexto() {
+        uint32_t n = valor<uint32_t>();
+        if (error || (size_t)(fin - actual) < n) {
+            error = true;
+            return string_view();
+        }
+        string_view s(actual, n);
+        actual += n;
+        return s;
+    }
+
+    /// @brief Marca la lectura como inválida (datos incoherentes).
+    void invalidar() { error = true; }
+
+    /// @brief Indica si todas las lecturas fueron válidas.
+    bool correcto() const { return !error; }
+};
+
+#endif
@@ -1,252 +1,1207 @@
 #ifndef NOTICIA_H
 #define NOTICIA_H
 
+#include <algorithm>
+#include <climits>
+#include <cstdint>
 #include <iostream>
+#include <deque>
+#include <functional>
+#include <map>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
-#include <cstdlib>
-#include <ctime>
 #include "empresa.h"
+#include "fecha.h"
+#include "aleatorio.h"
+#include "memoria.h"
+#include "paralelo.h"
 using namespace std;
 
-/// @brief Estructura que representa una noticia con impacto, título, descripción, sector afectado, fecha y puntero al siguiente nodo.
+/// @brief Estructura que representa una noticia con impacto, título, descripción, sector afectado y fecha.
 /**
  * Estructura utilizada para almacenar la información de una noticia en la cola de prioridad.
+ * Los textos son vistas a la tabla de textos internados de la cola (cada
+ * título, descripción o sector distinto se guarda una vez), así que la
+ * noticia no reserva memoria propia y es trivialmente destructible.
  */
 struct Noticia {
-    int impacto;             ///< Nivel de impacto de 1 a 10
-    string titulo;           ///< Título de la noticia
-    string descripcion;      ///< Descripción de la noticia
-    string sectorAfectado;   ///< Sector afectado por la noticia
-    string fecha;            ///< Fecha en formato "YYYY-MM-DD"
-    bool esPositiva;         ///< Indica si la noticia es positiva (true) o negativa (false)
-    Noticia* siguiente;      ///< Puntero a la siguiente noticia en la lista
+    int impacto;                ///< Nivel de impacto de 1 a 10
+    uint32_t orden;             ///< Número de inserción (desempata noticias de igual impacto; ver IndiceNoticias)
+    string_view titulo;         ///< Título de la noticia
+    string_view descripcion;    ///< Descripción de la noticia
+    string_view sectorAfectado; ///< Sector afectado por la noticia
+    Fecha fecha;                ///< Fecha de la noticia
+    bool esPositiva;            ///< Indica si la noticia es positiva (true) o negativa (false)
+
+    /// @brief Noticia vacía.
+    Noticia() : impacto(0), orden(0), esPositiva(true) {}
 
     /**
      * @brief Constructor de la estructura Noticia.
      * @param imp Nivel de impacto de la noticia.
-     * @param t Título de la noticia.
-     * @param d Descripción de la noticia.
-     * @param s Sector afectado.
+     * @param t Título de la noticia (debe vivir tanto como la noticia).
+     * @param d Descripción de la noticia (ídem).
+     * @param s Sector afectado (ídem).
      * @param f Fecha de la noticia.
      * @param positiva true si la noticia es positiva, false si es negativa.
      */
-    Noticia(int imp, string t, string d, string s, string f, bool positiva) {
+    Noticia(int imp, string_view t, string_view d, string_view s, Fecha f, bool positiva) {
         impacto = imp;
+        orden = 0;
         titulo = t;
         descripcion = d;
         sectorAfectado = s;
         fecha = f;
         esPositiva = positiva;
-        siguiente = nullptr;
     }
 };
 
-/// @brief Clase que implementa una cola de prioridad para noticias, ordenadas por impacto.
 /**
- * Permite insertar, mostrar, buscar, extraer y ordenar noticias, así como calcular estadísticas.
+ * @brief Noticia quitada de la cola, dueña de sus textos.
+ *
+ * Una Noticia solo tiene vistas a la tabla de textos de su cola, que puede
+ * reconstruirse en cualquier inserción; al salir de la cola los textos se
+ * copian para que sigan siendo válidos.
  */
-class ColaPrioridadNoticias {
+struct NoticiaExtraida {
+    int impacto = 0;        ///< Nivel de impacto de 1 a 10
+    string titulo;          ///< Título de la noticia
+    string descripcion;     ///< Descripción de la noticia
+    string sectorAfectado;  ///< Sector afectado por la noticia
+    Fecha fecha;            ///< Fecha de la noticia
+    bool esPositiva = true; ///< Indica si la noticia es positiva (true) o negativa (false)
+};
+
+/**
+ * @brief Entrada del índice cronológico: fecha e impacto junto al puntero,
+ *        para comparar sin visitar la noticia salvo en los empates.
+ */
+struct ClaveFecha {
+    Fecha fecha;       ///< Fecha de la noticia
+    int impacto;       ///< Impacto (a igual fecha, mayor impacto primero)
+    Noticia* noticia;  ///< Noticia (a igual fecha e impacto, la de menor número de inserción primero)
+};
+
+/**
+ * @brief Orden cronológico de las noticias; las de una misma fecha quedan en
+ *        orden de prioridad. Admite comparar contra una Fecha para buscar rangos.
+ */
+struct AntesPorFecha {
+    bool operator()(const ClaveFecha& a, const ClaveFecha& b) const {
+        if (a.fecha != b.fecha) return a.fecha < b.fecha;
+        if (a.impacto != b.impacto) return a.impacto > b.impacto;
+        return a.noticia->orden < b.noticia->orden;
+    }
+    bool operator()(const ClaveFecha& a, Fecha f) const { return a.fecha < f; }
+    bool operator()(Fecha f, const ClaveFecha& b) const { return f < b.fecha; }
+};
+
+/// Índice de prioridad: un grupo por impacto (de mayor a menor), en orden de inserción
+typedef map<int, deque<Noticia*>, greater<int>> IndicePrioridadNoticias;
+
+/**
+ * @brief Iterador en orden de prioridad: recorre los grupos de mayor a menor
+ *        impacto y cada grupo en orden de inserción.
+ */
+class IteradorPrioridad {
 private:
-    Noticia* frente; ///< Puntero al primer elemento de la cola
+    IndicePrioridadNoticias::const_iterator grupo;  ///< Grupo actual
+    IndicePrioridadNoticias::const_iterator fin;    ///< Fin de los grupos
+    size_t posicion;                                ///< Posición dentro del grupo
 
 public:
-    /// @brief Constructor de la cola de prioridad.
-    ColaPrioridadNoticias() {
-        frente = nullptr;
+    /**
+     * @brief Constructor.
+     * @param g Grupo inicial.
+     * @param f Fin de los grupos.
+     */
+    IteradorPrioridad(IndicePrioridadNoticias::const_iterator g, IndicePrioridadNoticias::const_iterator f)
+        : grupo(g), fin(f), posicion(0) {}
+
+    /// @brief Noticia actual.
+    Noticia* operator*() const { return grupo->second[posicion]; }
+
+    /// @brief Avanza a la siguiente noticia en orden de prioridad.
+    IteradorPrioridad& operator++() {
+        if (++posicion == grupo->second.size()) {
+            ++grupo;
+            posicion = 0;
+        }
+        return *this;
     }
 
-    /// @brief Verifica si la cola está vacía.
-    /// @return true si la cola está vacía, false en caso contrario.
-    bool estaVacia() {
-        return frente == nullptr;
+    /// @brief Compara iteradores.
+    bool operator!=(const IteradorPrioridad& otro) const { return grupo != otro.grupo || posicion != otro.posicion; }
+};
+
+/// Tramos del índice cronológico (ver IndiceFechaNoticias)
+typedef vector<vector<ClaveFecha>> TramosFecha;
+
+/**
+ * @brief Iterador en orden cronológico sobre el índice de fechas: un tramo y
+ *        una posición dentro de él (el fin es el tramo siguiente al último).
+ */
+class IteradorFecha {
+private:
+    const TramosFecha* tramos;
+    size_t tramo;
+    size_t posicion;
+
+public:
+    /**
+     * @brief Constructor.
+     * @param t Tramos del índice.
+     * @param i Tramo actual.
+     * @param p Posición dentro del tramo (menor que su tamaño, o 0 en el fin).
+     */
+    IteradorFecha(const TramosFecha* t, size_t i, size_t p) : tramos(t), tramo(i), posicion(p) {}
+    /// @brief Noticia actual.
+    Noticia* operator*() const { return (*tramos)[tramo][posicion].noticia; }
+    /// @brief Avanza a la siguiente noticia en orden cronológico.
+    IteradorFecha& operator++() {
+        if (++posicion == (*tramos)[tramo].size()) {
+            ++tramo;
+            posicion = 0;
+        }
+        return *this;
+    }
+    /// @brief Compara iteradores.
+    bool operator!=(const IteradorFecha& otro) const { return tramo != otro.tramo || posicion != otro.posicion; }
+    /// @brief Igualdad de iteradores.
+    bool operator==(const IteradorFecha& otro) const { return !(*this != otro); }
+};
+
+/**
+ * @brief Índice cronológico de la cola de noticias, sin un nodo por noticia.
+ *
+ * Las claves (16 bytes) se guardan ordenadas en tramos contiguos de hasta
+ * TRAMO entradas. Insertar o quitar busca el tramo por su última clave en
+ * O(log n) y desplaza a lo sumo un tramo: uno que se pasa de TRAMO se parte
+ * en dos, uno vacío desaparece y uno casi vacío se une a un vecino. Las
+ * noticias que llegan en orden cronológico se agregan al final del último
+ * tramo sin desplazar nada. Insertar o quitar invalida los iteradores.
+ */
+class IndiceFechaNoticias {
+private:
+    /// Entradas máximas de un tramo
+    static const size_t TRAMO = 512;
+
+    TramosFecha tramos;  ///< Tramos no vacíos, en orden cronológico
+
+    /// @brief Primer tramo cuya última clave no es anterior a `clave` (tramos.size() si no hay).
+    template <typename Clave>
+    size_t tramoDe(const Clave& clave) const {
+        return partition_point(tramos.begin(), tramos.end(),
+                               [&](const vector<ClaveFecha>& t) { return AntesPorFecha()(t.back(), clave); }) -
+               tramos.begin();
+    }
+
+    /// @brief Agrega el tramo t + 1 al final del tramo t.
+    void unir(size_t t) {
+        tramos[t].insert(tramos[t].end(), tramos[t + 1].begin(), tramos[t + 1].end());
+        tramos.erase(tramos.begin() + t + 1);
     }
 
+public:
     /**
-     * @brief Inserta una noticia en la cola de prioridad según su impacto.
-     * @param impacto Nivel de impacto de la noticia.
-     * @param titulo Título de la noticia.
-     * @param descripcion Descripción de la noticia.
-     * @param sector Sector afectado.
-     * @param fecha Fecha de la noticia.
-     * @param esPositiva true si la noticia es positiva, false si es negativa.
+     * @brief Agrega una noticia. O(log n + TRAMO); O(1) si es la más reciente.
+     * @param clave Clave de la noticia (su número de inserción ya asignado).
      */
-    void insertar(int impacto, string titulo, string descripcion, string sector, string fecha, bool esPositiva = true) {
-        Noticia* nueva = new Noticia(impacto, titulo, descripcion, sector, fecha, esPositiva);
+    void insertar(const ClaveFecha& clave) {
+        size_t t = tramoDe(clave);
+        if (t == tramos.size()) {
+            // Posterior a todas: al final del último tramo, o en uno nuevo si está lleno
+            if (tramos.empty() || tramos.back().size() == TRAMO) tramos.emplace_back();
+            tramos.back().push_back(clave);
+            return;
+        }
+        vector<ClaveFecha>& tramo = tramos[t];
+        tramo.insert(upper_bound(tramo.begin(), tramo.end(), clave, AntesPorFecha()), clave);
+        if (tramo.size() > TRAMO) {
+            vector<ClaveFecha> segunda(tramo.begin() + TRAMO / 2, tramo.end());
+            tramo.erase(tramo.begin() + TRAMO / 2, tramo.end());
+            tramo.shrink_to_fit();
+            tramos.insert(tramos.begin() + t + 1, std::move(segunda));
+        }
+    }
 
-        if (frente == nullptr || impacto > frente->impacto) {
-            nueva->siguiente = frente;
-            frente = nueva;
-        } else {
-            Noticia* actual = frente;
-            while (actual->siguiente != nullptr && actual->siguiente->impacto >= impacto) {
-                actual = actual->siguiente;
+    /**
+     * @brief Quita una noticia. O(log n + TRAMO).
+     * @param clave Clave con la que se insertó (con el número de inserción actual de la noticia).
+     */
+    void quitar(const ClaveFecha& clave) {
+        size_t t = tramoDe(clave);
+        vector<ClaveFecha>& tramo = tramos[t];
+        tramo.erase(lower_bound(tramo.begin(), tramo.end(), clave, AntesPorFecha()));
+        if (tramo.empty()) {
+            tramos.erase(tramos.begin() + t);
+        } else if (tramo.size() < TRAMO / 4) {
+            // Dos tramos vecinos casi vacíos siempre caben en uno
+            if (t + 1 < tramos.size() && tramo.size() + tramos[t + 1].size() <= TRAMO) unir(t);
+            else if (t > 0 && tramos[t - 1].size() + tramo.size() <= TRAMO) unir(t - 1);
+            else if (tramo.size() < tramo.capacity() / 4) tramo.shrink_to_fit();
+        }
+    }
+
+    /// @brief Primera noticia en orden cronológico.
+    IteradorFecha begin() const { return IteradorFecha(&tramos, 0, 0); }
+    /// @brief Iterador de fin.
+    IteradorFecha end() const { return IteradorFecha(&tramos, tramos.size(), 0); }
+
+    /// @brief Primera noticia con fecha igual o posterior a `fecha`. O(log n).
+    IteradorFecha desde(Fecha fecha) const {
+        size_t t = tramoDe(fecha);
+        if (t == tramos.size()) return end();
+        const vector<ClaveFecha>& tramo = tramos[t];
+        return IteradorFecha(&tramos, t, lower_bound(tramo.begin(), tramo.end(), fecha, AntesPorFecha()) - tramo.begin());
+    }
+
+    /// @brief Primera noticia con fecha posterior a `fecha`. O(log n).
+    IteradorFecha despuesDe(Fecha fecha) const { return desde(fecha + 1); }
+};
+
+/**
+ * @brief Vista recorrible con for de un tramo del índice cronológico.
+ */
+class RangoNoticias {
+private:
+    IteradorFecha inicio, fin;
+
+public:
+    /**
+     * @brief Constructor.
+     * @param i Primera noticia del tramo.
+     * @param f Fin del tramo (exclusivo).
+     */
+    RangoNoticias(IteradorFecha i, IteradorFecha f) : inicio(i), fin(f) {}
+
+    /// @brief Iterador a la primera noticia del tramo.
+    IteradorFecha begin() const { return inicio; }
+    /// @brief Iterador de fin.
+    IteradorFecha end() const { return fin; }
+    /// @brief Indica si el tramo no tiene noticias.
+    bool empty() const { return inicio == fin; }
+};
+
+/**
+ * @brief Pliega un carácter UTF-8 de dos bytes del rango Latin-1 (0xC3 0x80-0xBF)
+ *        a su letra ASCII minúscula sin tilde.
+ * @param segundo Segundo byte de la secuencia.
+ * @return Letra plegada, o 0 si el carácter es un separador (× y ÷).
+ */
+inline char plegarLatino(unsigned char segundo) {
+    // À..ß y à..ÿ comparten la misma tabla de 32 entradas
+    static const char TABLA[33] = "aaaaaaaceeeeiiiidnooooo ouuuuyts";
+    if (segundo == 0xBF) return 'y';  // ÿ (en la fila de mayúsculas es ß)
+    char c = TABLA[(segundo - 0x80) & 0x1F];
+    return c == ' ' ? 0 : c;
+}
+
+/**
+ * @brief Divide un texto en términos de búsqueda plegados: minúsculas, sin tildes
+ *        ("Energía" -> "energia"), separados por cualquier carácter no alfanumérico.
+ *        Los caracteres no latinos se conservan tal cual dentro del término.
+ * @param texto Texto en UTF-8.
+ * @param terminos Términos encontrados (se agregan al final, con repeticiones).
+ */
+inline void tokenizarTexto(string_view texto, vector<string>& terminos) {
+    string actual;
+    for (size_t i = 0; i < texto.size(); ++i) {
+        unsigned char c = texto[i];
+        char plegado = 0;
+        if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+            plegado = c;
+        } else if (c >= 'A' && c <= 'Z') {
+            plegado = c - 'A' + 'a';
+        } else if (c == 0xC3 && i + 1 < texto.size()) {
+            plegado = plegarLatino(texto[++i]);
+        } else if (c >= 0x80) {
+            actual += (char)c;  // Otro carácter multibyte: parte del término
+            continue;
+        }
+        if (plegado) {
+            actual += plegado;
+        } else if (!actual.empty()) {
+            terminos.push_back(actual);
+            actual.clear();
+        }
+    }
+    if (!actual.empty()) terminos.push_back(actual);
+}
+
+/**
+ * @brief Texto plegado completo (sin separar en términos), para comparar nombres de sector.
+ * @param texto Texto en UTF-8.
+ * @return Términos plegados unidos por un espacio.
+ */
+inline string plegarTexto(string_view texto) {
+    vector<string> terminos;
+    tokenizarTexto(texto, terminos);
+    string plegado;
+    for (const string& t : terminos) {
+        if (!plegado.empty()) plegado += ' ';
+        plegado += t;
+    }
+    return plegado;
+}
+
+/**
+ * @brief Índice invertido de la cola de noticias: término plegado (de título y
+ *        descripción) y sector -> números de inserción de las noticias.
+ *
+ * El índice asigna los números de inserción (Noticia::orden). Las listas de
+ * cada término quedan ordenadas por número de inserción porque las noticias se
+ * agregan en ese orden, así que AND y OR son mezclas lineales.
+ * Al extraer una noticia solo se marca su casilla; cuando las marcadas superan
+ * a las vigentes se compacta todo y las vigentes se renumeran 0, 1, 2... sin
+ * cambiar su orden relativo. Así una consulta recorre O(k) entradas, quitar
+ * cuesta O(1) amortizado y porOrden nunca pasa del doble de las noticias en la cola.
+ * Los textos de las noticias deben estar internados (TablaTextos): los
+ * términos de cada título o descripción y el sector se recuerdan por dirección,
+ * así que un texto repetido se tokeniza y se pliega una sola vez.
+ */
+class IndiceNoticias {
+private:
+    vector<vector<uint32_t>> listas;                    ///< Noticias de cada término o sector, por número de inserción
+    unordered_map<string, size_t> porTermino;           ///< Término -> su lista
+    map<string, size_t> terminosOrdenados;              ///< Los mismos términos en orden, para buscar prefijos
+    unordered_map<string, size_t> porSector;            ///< Sector plegado -> su lista
+    unordered_map<const char*, size_t> sectorInternado; ///< Sector internado (por dirección) -> su lista
+    unordered_map<const char*, vector<size_t>> terminosDeTexto; ///< Texto internado (por dirección) -> listas de sus términos
+    vector<Noticia*> porOrden;                          ///< Noticia de cada número de inserción (nullptr si salió)
+    size_t vigentes;                                    ///< Noticias indexadas que siguen en la cola
+    size_t quitadas;                                    ///< Noticias quitadas desde la última compactación
+
+    /// @brief Quita las noticias que salieron y renumera las vigentes (O(total de entradas)).
+    void compactar() {
+        // Primero los números nuevos: las listas los leen a través de porOrden, que sigue con los viejos
+        uint32_t siguiente = 0;
+        for (Noticia* noticia : porOrden) {
+            if (noticia) noticia->orden = siguiente++;
+        }
+        for (vector<uint32_t>& lista : listas) {
+            size_t j = 0;
+            for (uint32_t orden : lista) {
+                if (porOrden[orden]) lista[j++] = porOrden[orden]->orden;
             }
-            nueva->siguiente = actual->siguiente;
-            actual->siguiente = nueva;
+            lista.resize(j);
+            if (lista.size() < lista.capacity() / 4) lista.shrink_to_fit();
         }
+        porOrden.erase(remove(porOrden.begin(), porOrden.end(), nullptr), porOrden.end());
+        if (porOrden.size() < porOrden.capacity() / 4) porOrden.shrink_to_fit();
+        quitadas = 0;
     }
 
-    /// @brief Muestra todas las noticias en la cola, en orden de prioridad.
-    void mostrar() {
-        Noticia* actual = frente;
-        while (actual != nullptr) {
-            cout << "[" << actual->fecha << "] "
-                 << "(Impacto: " << actual->impacto << ") "
-                 << actual->titulo << " - " << actual->sectorAfectado << endl;
-            actual = actual->siguiente;
+    /// @brief Posición de la lista de un término, creándola si es nuevo.
+    size_t listaDeTermino(const string& termino) {
+        auto it = porTermino.find(termino);
+        if (it != porTermino.end()) return it->second;
+        porTermino.emplace(termino, listas.size());
+        terminosOrdenados.emplace(termino, listas.size());
+        listas.emplace_back();
+        return listas.size() - 1;
+    }
+
+    /// @brief Lista de un sector internado, creándola si es nuevo.
+    vector<uint32_t>& listaDeSector(string_view sector) {
+        auto it = sectorInternado.find(sector.data());
+        if (it != sectorInternado.end()) return listas[it->second];
+        string plegado = plegarTexto(sector);
+        auto jt = porSector.find(plegado);
+        size_t id = jt != porSector.end() ? jt->second : listas.size();
+        if (id == listas.size()) {
+            porSector.emplace(plegado, id);
+            listas.emplace_back();
         }
+        sectorInternado.emplace(sector.data(), id);
+        return listas[id];
+    }
+
+    /// @brief Listas de los términos de un texto internado; se tokeniza solo la primera vez.
+    const vector<size_t>& terminosDe(string_view texto) {
+        auto it = terminosDeTexto.find(texto.data());
+        if (it != terminosDeTexto.end()) return it->second;
+        vector<string> terminos;
+        tokenizarTexto(texto, terminos);
+        sort(terminos.begin(), terminos.end());
+        terminos.erase(unique(terminos.begin(), terminos.end()), terminos.end());
+        vector<size_t> ids;
+        ids.reserve(terminos.size());
+        for (const string& t : terminos) ids.push_back(listaDeTermino(t));
+        return terminosDeTexto.emplace(texto.data(), std::move(ids)).first->second;
+    }
+
+    /// @brief Agrega una noticia al final de una lista, sin repetirla.
+    static void anotar(vector<uint32_t>& lista, uint32_t orden) {
+        if (lista.empty() || lista.back() != orden) lista.push_back(orden);
     }
 
     /**
-     * @brief Busca y muestra noticias que pertenecen a un sector específico.
-     * @param sectorClave Nombre del sector a buscar.
+     * @brief Noticias de un término (o de todos los términos con ese prefijo).
+     * @param termino Término ya plegado.
+     * @param prefijo true para aceptar cualquier término que empiece así.
+     * @param salida Números de inserción ordenados y sin repetir.
      */
-    void buscarPorSector(string sectorClave) {
-        Noticia* actual = frente;
-        cout << "\n🔍 Noticias en el sector '" << sectorClave << "':\n";
-        while (actual != nullptr) {
-            if (actual->sectorAfectado == sectorClave) {
-                cout << "- " << actual->titulo << " (Impacto: " << actual->impacto << ")\n";
-            }
-            actual = actual->siguiente;
+    void postulados(const string& termino, bool prefijo, vector<uint32_t>& salida) const {
+        salida.clear();
+        if (!prefijo) {
+            auto it = porTermino.find(termino);
+            if (it != porTermino.end()) salida = listas[it->second];
+            return;
+        }
+        size_t encontradas = 0;
+        for (auto it = terminosOrdenados.lower_bound(termino);
+             it != terminosOrdenados.end() && it->first.compare(0, termino.size(), termino) == 0; ++it) {
+            salida.insert(salida.end(), listas[it->second].begin(), listas[it->second].end());
+            encontradas++;
+        }
+        if (encontradas > 1) {
+            sort(salida.begin(), salida.end());
+            salida.erase(unique(salida.begin(), salida.end()), salida.end());
+        }
+    }
+
+    /// @brief Convierte números de inserción en noticias, omitiendo las que salieron.
+    vector<Noticia*> resolver(const vector<uint32_t>& ordenes) const {
+        vector<Noticia*> noticias;
+        noticias.reserve(ordenes.size());
+        for (uint32_t orden : ordenes) {
+            if (porOrden[orden]) noticias.push_back(porOrden[orden]);
         }
+        return noticias;
     }
 
+public:
+    /// @brief Constructor.
+    IndiceNoticias() : vigentes(0), quitadas(0) {}
+
     /**
-     * @brief Busca y muestra noticias cuyo título contiene una palabra clave.
-     * @param palabra Palabra clave a buscar en los títulos.
+     * @brief Indexa una noticia nueva y le asigna el siguiente número de inserción.
+     * @param noticia Noticia recién insertada en la cola.
      */
-    void buscarPorPalabraClave(string palabra) {
-        Noticia* actual = frente;
-        cout << "\n🔍 Noticias con '" << palabra << "' en el título:\n";
-        while (actual != nullptr) {
-            if (actual->titulo.find(palabra) != string::npos) {
-                cout << "- " << actual->titulo << " (" << actual->sectorAfectado << ")\n";
-            }
-            actual = actual->siguiente;
+    void agregar(Noticia* noticia) {
+        noticia->orden = (uint32_t)porOrden.size();
+        porOrden.push_back(noticia);
+        // Los números de inserción crecen: un término del título y de la descripción se anota una vez
+        for (size_t id : terminosDe(noticia->titulo)) anotar(listas[id], noticia->orden);
+        for (size_t id : terminosDe(noticia->descripcion)) anotar(listas[id], noticia->orden);
+        listaDeSector(noticia->sectorAfectado).push_back(noticia->orden);
+        vigentes++;
+    }
+
+    /**
+     * @brief Quita una noticia del índice. O(1) amortizado; puede renumerar las demás.
+     * @param noticia Noticia que sale de la cola.
+     */
+    void quitar(const Noticia* noticia) {
+        porOrden[noticia->orden] = nullptr;
+        vigentes--;
+        if (++quitadas > vigentes) compactar();
+    }
+
+    /**
+     * @brief Noticias que contienen todos los términos (AND) o alguno (OR).
+     * @param consulta Texto de la consulta; se tokeniza y pliega igual que las noticias.
+     * @param todos true para exigir todos los términos, false para aceptar cualquiera.
+     * @param prefijo true para que cada término acepte palabras que empiecen así ("petr" -> "petroleo").
+     * @return Noticias encontradas, en orden de inserción. O(k) sobre las listas de los términos.
+     */
+    vector<Noticia*> buscar(const string& consulta, bool todos = true, bool prefijo = false) const {
+        vector<string> terminos;
+        tokenizarTexto(consulta, terminos);
+        if (terminos.empty()) return vector<Noticia*>();
+        vector<uint32_t> resultado, lista, mezcla;
+        postulados(terminos[0], prefijo, resultado);
+        for (size_t i = 1; i < terminos.size(); ++i) {
+            if (todos && resultado.empty()) break;
+            postulados(terminos[i], prefijo, lista);
+            mezcla.clear();
+            if (todos) set_intersection(resultado.begin(), resultado.end(), lista.begin(), lista.end(), back_inserter(mezcla));
+            else set_union(resultado.begin(), resultado.end(), lista.begin(), lista.end(), back_inserter(mezcla));
+            resultado.swap(mezcla);
         }
+        return resolver(resultado);
     }
 
-    /// @brief Detecta si hay una alerta de crisis (3 o más noticias con impacto >= 8).
-    /// @return true si hay alerta de crisis, false en caso contrario.
-    bool hayAlertaDeCrisis() {
-        Noticia* actual = frente;
-        int contador = 0;
-        while (actual != nullptr) {
-            if (actual->impacto >= 8) {
-                contador++;
-                if (contador >= 3) return true;
+    /**
+     * @brief Noticias de un sector (sin distinguir mayúsculas ni tildes). O(k).
+     * @param sector Nombre del sector.
+     * @return Noticias del sector, en orden de inserción.
+     */
+    vector<Noticia*> buscarSector(const string& sector) const {
+        auto it = porSector.find(plegarTexto(sector));
+        if (it == porSector.end()) return vector<Noticia*>();
+        return resolver(listas[it->second]);
+    }
+
+    /// @brief Olvida los textos reconocidos por dirección (antes de liberar la tabla de textos).
+    void olvidarTextos() {
+        sectorInternado.clear();
+        terminosDeTexto.clear();
+    }
+};
+
+/**
+ * @brief Umbrales de alerta de crisis de un sector.
+ *
+ * Un sector entra en alerta si en la ventana corta acumula al menos
+ * altasVentanaCorta noticias de alto impacto, o si en la ventana larga la
+ * suma de impactos llega a sumaVentanaLarga (0 desactiva cada condición).
+ */
+struct UmbralCrisis {
+    int altasVentanaCorta = 3;   ///< Noticias de alto impacto en la ventana corta
+    int sumaVentanaLarga = 60;   ///< Suma de impactos en la ventana larga
+};
+
+/**
+ * @brief Contadores de un sector en las dos ventanas del detector de crisis.
+ */
+struct EstadoCrisisSector {
+    string sector;               ///< Sector (como llegó en su primera noticia)
+    int noticiasCorta = 0;       ///< Noticias en la ventana corta
+    int altasCorta = 0;          ///< Noticias de alto impacto en la ventana corta
+    long long sumaCorta = 0;     ///< Suma de impactos en la ventana corta
+    int noticiasLarga = 0;       ///< Noticias en la ventana larga
+    int altasLarga = 0;          ///< Noticias de alto impacto en la ventana larga
+    long long sumaLarga = 0;     ///< Suma de impactos en la ventana larga
+    bool enAlerta = false;       ///< Si el sector supera hoy alguno de sus umbrales
+
+    /// @brief Impacto promedio en la ventana corta.
+    float promedioCorta() const { return noticiasCorta > 0 ? (float)sumaCorta / noticiasCorta : 0; }
+    /// @brief Impacto promedio en la ventana larga.
+    float promedioLarga() const { return noticiasLarga > 0 ? (float)sumaLarga / noticiasLarga : 0; }
+};
+
+/**
+ * @brief Alerta emitida cuando un sector cruza sus umbrales de crisis.
+ */
+struct AlertaCrisis {
+    Fecha fecha;                 ///< Fecha de la noticia que disparó la alerta
+    EstadoCrisisSector estado;   ///< Contadores del sector en ese momento
+    bool porVentanaCorta;        ///< true si la disparó la ventana corta, false si la larga
+};
+
+/**
+ * @brief Detector incremental de crisis por sector sobre ventanas deslizantes
+ *        de días hábiles (por defecto los últimos 5 y 20).
+ *
+ * El "hoy" del detector es el día hábil de la noticia más reciente recibida.
+ * Cada sector guarda una cubeta por día de la ventana larga en un arreglo
+ * circular y los totales de ambas ventanas; registrar y retirar una noticia
+ * cuestan O(1), y avanzar el día expira una cubeta por día transcurrido
+ * (O(1) amortizado). Los sectores que no reciben noticias se ponen al día
+ * cuando se consultan. Las noticias anteriores a la ventana larga no cuentan.
+ * Como el índice invertido, reconoce el sector de una noticia por la
+ * dirección de su texto internado.
+ * Una alerta se emite al pasar de "sin alerta" a "en alerta", no en cada noticia.
+ */
+class DetectorCrisis {
+private:
+    /// @brief Noticias de un sector en un día hábil.
+    struct Cubeta {
+        int32_t dia = INT32_MIN;  ///< Día hábil al que corresponde la cubeta
+        int noticias = 0;
+        int altas = 0;
+        long long suma = 0;
+    };
+
+    /// @brief Ventanas de un sector.
+    struct Sector {
+        EstadoCrisisSector estado;
+        UmbralCrisis umbral;
+        vector<Cubeta> cubetas;   ///< Una por día de la ventana larga (día módulo ventanaLarga)
+        int32_t hoy;              ///< Día hábil hasta el que están al día los totales
+        bool umbralPropio;        ///< true si el umbral se configuró para este sector
+    };
+
+    int ventanaCorta;                            ///< Días hábiles de la ventana corta
+    int ventanaLarga;                            ///< Días hábiles de la ventana larga
+    int impactoAlto;                             ///< Impacto desde el que una noticia es de alto impacto
+    UmbralCrisis umbralGeneral;                  ///< Umbral de los sectores sin uno propio
+    int32_t hoy;                                 ///< Día hábil de la noticia más reciente
+    vector<Sector> sectores;
+    unordered_map<string, size_t> porSector;     ///< Sector plegado -> posición en sectores
+    unordered_map<const char*, size_t> internados; ///< Sector internado (por dirección) -> posición
+
+    /// @brief Cubeta del día dado en el arreglo circular.
+    Cubeta& cubeta(Sector& s, int32_t dia) const {
+        int32_t i = dia % ventanaLarga;
+        return s.cubetas[i < 0 ? i + ventanaLarga : i];
+    }
+
+    /// @brief Posición de un sector de una noticia (texto internado), creándolo si es nuevo.
+    size_t posicion(string_view sector) {
+        auto it = internados.find(sector.data());
+        if (it != internados.end()) return it->second;
+        size_t id = posicionPorNombre(sector);
+        internados.emplace(sector.data(), id);
+        return id;
+    }
+
+    /// @brief Posición de un sector por su nombre (sin distinguir mayúsculas ni tildes), creándolo si es nuevo.
+    size_t posicionPorNombre(string_view sector) {
+        string plegado = plegarTexto(sector);
+        auto jt = porSector.find(plegado);
+        size_t id = jt != porSector.end() ? jt->second : sectores.size();
+        if (id == sectores.size()) {
+            Sector nuevo;
+            nuevo.estado.sector = string(sector);
+            nuevo.umbral = umbralGeneral;
+            nuevo.cubetas.assign(ventanaLarga, Cubeta());
+            nuevo.hoy = hoy;
+            nuevo.umbralPropio = false;
+            sectores.push_back(std::move(nuevo));
+            porSector.emplace(plegado, id);
+        }
+        return id;
+    }
+
+    /// @brief Expira de las ventanas de un sector los días anteriores a hoy.
+    void ponerAlDia(Sector& s) const {
+        if (s.hoy >= hoy) return;
+        EstadoCrisisSector& e = s.estado;
+        if (hoy - s.hoy >= ventanaLarga) {
+            // Todo quedó fuera de ambas ventanas
+            for (Cubeta& c : s.cubetas) c = Cubeta();
+            e.noticiasCorta = e.altasCorta = e.noticiasLarga = e.altasLarga = 0;
+            e.sumaCorta = e.sumaLarga = 0;
+        } else {
+            for (int32_t dia = s.hoy + 1; dia <= hoy; ++dia) {
+                Cubeta& sale = cubeta(s, dia - ventanaCorta);
+                if (sale.dia == dia - ventanaCorta) {
+                    e.noticiasCorta -= sale.noticias;
+                    e.altasCorta -= sale.altas;
+                    e.sumaCorta -= sale.suma;
+                }
+                Cubeta& vieja = cubeta(s, dia);  // Misma casilla que dia - ventanaLarga
+                if (vieja.dia == dia - ventanaLarga) {
+                    e.noticiasLarga -= vieja.noticias;
+                    e.altasLarga -= vieja.altas;
+                    e.sumaLarga -= vieja.suma;
+                }
+                vieja = Cubeta();
+                vieja.dia = dia;
             }
-            actual = actual->siguiente;
         }
-        return false;
+        s.hoy = hoy;
+        e.enAlerta = superaVentanaCorta(s) || superaVentanaLarga(s);
     }
 
-    /// @brief Calcula el promedio del impacto de todas las noticias en la cola.
-    /// @return Promedio del impacto (float).
-    float promedioImpacto() {
-        if (estaVacia()) return 0;
+    static bool superaVentanaCorta(const Sector& s) {
+        return s.umbral.altasVentanaCorta > 0 && s.estado.altasCorta >= s.umbral.altasVentanaCorta;
+    }
+
+    static bool superaVentanaLarga(const Sector& s) {
+        return s.umbral.sumaVentanaLarga > 0 && s.estado.sumaLarga >= s.umbral.sumaVentanaLarga;
+    }
+
+    /// @brief Suma (signo 1) o resta (signo -1) una noticia de las ventanas de su sector.
+    void contar(Sector& s, int32_t dia, int impacto, int signo) {
+        if (dia <= hoy - ventanaLarga) return;  // Fuera de la ventana larga
+        Cubeta& c = cubeta(s, dia);
+        if (c.dia != dia) {
+            if (signo < 0) return;  // Su día ya expiró
+            c = Cubeta();
+            c.dia = dia;
+        }
+        int alta = impacto >= impactoAlto ? signo : 0;
+        c.noticias += signo;
+        c.altas += alta;
+        c.suma += signo * impacto;
+        EstadoCrisisSector& e = s.estado;
+        e.noticiasLarga += signo;
+        e.altasLarga += alta;
+        e.sumaLarga += signo * impacto;
+        if (dia > hoy - ventanaCorta) {
+            e.noticiasCorta += signo;
+            e.altasCorta += alta;
+            e.sumaCorta += signo * impacto;
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor del detector.
+     * @param corta Días hábiles de la ventana corta.
+     * @param larga Días hábiles de la ventana larga (al menos la corta).
+     * @param alto Impacto desde el que una noticia cuenta como de alto impacto.
+     */
+    DetectorCrisis(int corta = 5, int larga = 20, int alto = 8) {
+        ventanaCorta = max(corta, 1);
+        ventanaLarga = max(larga, ventanaCorta);
+        impactoAlto = alto;
+        hoy = INT32_MIN / 2;
+    }
+
+    /// @brief Días hábiles de la ventana corta.
+    int diasVentanaCorta() const { return ventanaCorta; }
+    /// @brief Días hábiles de la ventana larga.
+    int diasVentanaLarga() const { return ventanaLarga; }
+    /// @brief Impacto desde el que una noticia es de alto impacto.
+    int impactoDeAlerta() const { return impactoAlto; }
+
+    /// @brief Fecha de la noticia más reciente (el "hoy" de las ventanas).
+    Fecha fechaActual() const { return Fecha::desdeIndiceHabil(hoy); }
+
+    /// @brief true si todavía no se ha registrado ninguna noticia.
+    bool vacio() const { return sectores.empty(); }
+
+    /**
+     * @brief Cambia el umbral de los sectores que no tienen uno propio.
+     * @param umbral Nuevo umbral general.
+     */
+    void configurarUmbralGeneral(const UmbralCrisis& umbral) {
+        umbralGeneral = umbral;
+        for (Sector& s : sectores) {
+            if (!s.umbralPropio) s.umbral = umbral;
+        }
+    }
+
+    /**
+     * @brief Fija el umbral de un sector (sin distinguir mayúsculas ni tildes).
+     *        Se aplica desde la próxima noticia del sector.
+     * @param sector Nombre del sector.
+     * @param umbral Umbral del sector.
+     */
+    void configurarUmbral(const string& sector, const UmbralCrisis& umbral) {
+        Sector& s = sectores[posicionPorNombre(sector)];
+        s.umbral = umbral;
+        s.umbralPropio = true;
+    }
 
-        Noticia* actual = frente;
-        float suma = 0;
-        int total = 0;
-        while (actual != nullptr) {
-            suma += actual->impacto;
-            total++;
-            actual = actual->siguiente;
+    /**
+     * @brief Escribe el umbral general y los umbrales propios de cada sector (ver SnapshotMercado).
+     * @param salida Escritor binario.
+     */
+    void guardarUmbrales(EscritorBinario& salida) const {
+        salida.valor<int32_t>(umbralGeneral.altasVentanaCorta);
+        salida.valor<int32_t>(umbralGeneral.sumaVentanaLarga);
+        uint32_t propios = 0;
+        for (const Sector& s : sectores) propios += s.umbralPropio;
+        salida.valor(propios);
+        for (const Sector& s : sectores) {
+            if (!s.umbralPropio) continue;
+            salida.texto(s.estado.sector);
+            salida.valor<int32_t>(s.umbral.altasVentanaCorta);
+            salida.valor<int32_t>(s.umbral.sumaVentanaLarga);
         }
-        return suma / total;
     }
 
-    /// @brief Extrae y retorna la noticia con mayor prioridad (mayor impacto).
-    /// @return Puntero a la noticia extraída, o nullptr si la cola está vacía.
-    Noticia* extraer() {
-        if (estaVacia()) return nullptr;
+    /**
+     * @brief Configura los umbrales escritos por guardarUmbrales().
+     * @param entrada Lector; si se acaba antes de tiempo queda inválido.
+     */
+    void cargarUmbrales(LectorBinario& entrada) {
+        UmbralCrisis general;
+        general.altasVentanaCorta = entrada.valor<int32_t>();
+        general.sumaVentanaLarga = entrada.valor<int32_t>();
+        uint32_t propios = entrada.valor<uint32_t>();
+        if (!entrada.correcto()) return;
+        configurarUmbralGeneral(general);
+        for (uint32_t k = 0; k < propios && entrada.correcto(); ++k) {
+            string sector = entrada.texto();
+            UmbralCrisis umbral;
+            umbral.altasVentanaCorta = entrada.valor<int32_t>();
+            umbral.sumaVentanaLarga = entrada.valor<int32_t>();
+            if (entrada.correcto()) configurarUmbral(sector, umbral);
+        }
+    }
 
-        Noticia* temp = frente;
-        frente = frente->siguiente;
-        temp->siguiente = nullptr;
-        return temp;
+    /**
+     * @brief Umbral vigente de un sector.
+     * @param sector Nombre del sector.
+     */
+    UmbralCrisis umbral(const string& sector) const {
+        auto it = porSector.find(plegarTexto(sector));
+        return it == porSector.end() ? umbralGeneral : sectores[it->second].umbral;
     }
 
-    /// @brief Llena un vector con punteros a todas las noticias en la cola (en orden actual).
-    void obtenerNoticias(vector<Noticia*>& noticias) {
-        Noticia* actual = frente;
-        while (actual) {
-            noticias.push_back(actual);
-            actual = actual->siguiente;
+    /**
+     * @brief Cuenta una noticia en las ventanas de su sector. O(1) amortizado.
+     * @param noticia Noticia recibida.
+     * @param alertas Si no es nullptr, recibe la alerta si el sector acaba de entrar en alerta.
+     */
+    void registrar(const Noticia* noticia, vector<AlertaCrisis>* alertas = nullptr) {
+        Sector& s = sectores[posicion(noticia->sectorAfectado)];
+        int32_t dia = noticia->fecha.indiceHabil();
+        if (dia > hoy) hoy = dia;
+        ponerAlDia(s);
+        bool estaba = s.estado.enAlerta;
+        contar(s, dia, noticia->impacto, 1);
+        bool corta = superaVentanaCorta(s);
+        s.estado.enAlerta = corta || superaVentanaLarga(s);
+        if (s.estado.enAlerta && !estaba && alertas) {
+            alertas->push_back({noticia->fecha, s.estado, corta});
         }
     }
 
-    // ======= ORDENAMIENTO POR FECHA (MERGE SORT) =======
+    /**
+     * @brief Descuenta una noticia de las ventanas de su sector (si todavía está en ellas). O(1).
+     * @param noticia Noticia que sale de la cola.
+     */
+    void retirar(const Noticia* noticia) {
+        Sector& s = sectores[posicion(noticia->sectorAfectado)];
+        ponerAlDia(s);
+        contar(s, noticia->fecha.indiceHabil(), noticia->impacto, -1);
+        s.estado.enAlerta = superaVentanaCorta(s) || superaVentanaLarga(s);
+    }
+
+    /// @brief Olvida los sectores reconocidos por dirección (antes de liberar la tabla de textos).
+    void olvidarTextos() { internados.clear(); }
 
     /**
-     * @brief Divide la lista enlazada de noticias en dos mitades.
-     * @param cabeza Puntero al inicio de la lista.
-     * @return Puntero al inicio de la segunda mitad.
+     * @brief Contadores de un sector a la fecha actual.
+     * @param sector Nombre del sector (sin distinguir mayúsculas ni tildes).
+     * @return Contadores del sector (en cero si no tiene noticias).
      */
-    Noticia* dividir(Noticia* cabeza) {
-        if (!cabeza || !cabeza->siguiente) return nullptr;
+    EstadoCrisisSector estado(const string& sector) {
+        auto it = porSector.find(plegarTexto(sector));
+        if (it == porSector.end()) {
+            EstadoCrisisSector vacio;
+            vacio.sector = sector;
+            return vacio;
+        }
+        ponerAlDia(sectores[it->second]);
+        return sectores[it->second].estado;
+    }
 
-        Noticia* lenta = cabeza;
-        Noticia* rapida = cabeza->siguiente;
+    /// @brief Contadores de todos los sectores a la fecha actual. O(sectores).
+    vector<EstadoCrisisSector> estados() {
+        vector<EstadoCrisisSector> salida;
+        salida.reserve(sectores.size());
+        for (Sector& s : sectores) {
+            ponerAlDia(s);
+            salida.push_back(s.estado);
+        }
+        return salida;
+    }
 
-        while (rapida && rapida->siguiente) {
-            lenta = lenta->siguiente;
-            rapida = rapida->siguiente->siguiente;
+    /// @brief Sectores en alerta a la fecha actual. O(sectores).
+    vector<string> sectoresEnAlerta() {
+        vector<string> salida;
+        for (Sector& s : sectores) {
+            ponerAlDia(s);
+            if (s.estado.enAlerta) salida.push_back(s.estado.sector);
         }
+        return salida;
+    }
+};
 
-        Noticia* mitad = lenta->siguiente;
-        lenta->siguiente = nullptr;
-        return mitad;
+/// @brief Clase que implementa una cola de prioridad para noticias, ordenadas por impacto.
+/**
+ * Cada noticia se guarda una sola vez y se indexa dos veces:
+ * - por prioridad: un grupo FIFO por nivel de impacto, de mayor a menor
+ *   (O(log g) por operación, con g niveles distintos: 10 en la práctica);
+ * - por fecha: claves ordenadas en tramos contiguos (IndiceFechaNoticias),
+ *   sin un nodo por noticia.
+ * insertar y extraer cuestan O(log n), ambos órdenes se recorren en O(n) en
+ * cualquier momento sin reordenar nada, y un rango de fechas cuesta
+ * O(log n + k). for (Noticia* n : cola) recorre en orden de prioridad.
+ * Un índice invertido (IndiceNoticias) resuelve las búsquedas por palabras y por sector,
+ * y un DetectorCrisis lleva las ventanas de alerta por sector a medida que llegan noticias.
+ * Las noticias se crean en un pool propio y sus textos se internan en una
+ * TablaTextos: un título repetido un millón de veces se guarda una vez. La
+ * tabla no libera textos sueltos: cuando guarda más del doble de los que
+ * pueden estar en uso, se reconstruye solo con los de las noticias vigentes.
+ * extraer entrega una NoticiaExtraida con copias de los textos.
+ * Memoria: con 1M noticias generadas ocupa unos 155 B por noticia (96 B fijos:
+ * el registro, su clave por fecha y dos punteros; el resto son el índice
+ * invertido, el detector y la holgura), y con títulos todos distintos unos
+ * 560 B. Sigue lejos de las pocas decenas de bytes por noticia que se
+ * buscaban; ver bench/memoriaNoticias.cpp.
+ * Permite insertar, mostrar, buscar y extraer noticias, así como calcular estadísticas.
+ */
+class ColaPrioridadNoticias {
+private:
+    TablaTextos textos;                 ///< Títulos, descripciones y sectores, una copia de cada uno
+    PoolNodos<Noticia> nodos;           ///< Memoria de las noticias
+    IndicePrioridadNoticias porImpacto; ///< Índice de prioridad (dueño de las noticias)
+    IndiceFechaNoticias porFecha;       ///< Índice cronológico
+    IndiceNoticias indice;              ///< Índice invertido de términos y sectores
+    DetectorCrisis detector;            ///< Ventanas deslizantes de alerta por sector
+    vector<AlertaCrisis> alertas;       ///< Alertas emitidas y aún no consultadas
+    size_t cantidad;                    ///< Noticias en la cola
+    long long sumaImpacto;              ///< Suma de los impactos, para el promedio en O(1)
+
+    /// Textos que la tabla puede guardar sin reconstruirse, además de tres por noticia
+    static const size_t TEXTOS_LIBRES = 4096;
+
+    /// @brief Muestra una noticia en una línea.
+    static void mostrarNoticia(const Noticia* actual) {
+        cout << "[" << actual->fecha << "] "
+             << "(Impacto: " << actual->impacto << ") "
+             << actual->titulo << " - " << actual->sectorAfectado << endl;
     }
 
     /**
-     * @brief Fusiona dos listas enlazadas de noticias ordenadas por fecha.
-     * @param a Puntero al inicio de la primera lista.
-     * @param b Puntero al inicio de la segunda lista.
-     * @return Puntero al inicio de la lista fusionada.
+     * @brief Copia a una tabla nueva solo los textos de las noticias vigentes y libera la anterior.
+     *
+     * Se llama cuando la tabla guarda más del doble de los textos que pueden
+     * estar en uso (tres por noticia), así que cuesta O(1) amortizado por texto
+     * descartado. Los índices que reconocen textos por dirección los olvidan.
      */
-    Noticia* fusionar(Noticia* a, Noticia* b) {
-        if (!a) return b;
-        if (!b) return a;
+    void compactarTextos() {
+        TablaTextos vigentes;
+        for (const auto& grupo : porImpacto) {
+            for (Noticia* n : grupo.second) {
+                n->titulo = vigentes.internar(n->titulo);
+                n->descripcion = vigentes.internar(n->descripcion);
+                n->sectorAfectado = vigentes.internar(n->sectorAfectado);
+            }
+        }
+        textos.intercambiar(vigentes);
+        indice.olvidarTextos();
+        detector.olvidarTextos();
+    }
 
-        if (a->fecha < b->fecha) {
-            a->siguiente = fusionar(a->siguiente, b);
-            return a;
-        } else {
-            b->siguiente = fusionar(a, b->siguiente);
-            return b;
+public:
+    /// @brief Constructor de la cola de prioridad.
+    ColaPrioridadNoticias() {
+        cantidad = 0;
+        sumaImpacto = 0;
+    }
+
+    ColaPrioridadNoticias(const ColaPrioridadNoticias&) = delete;
+    ColaPrioridadNoticias& operator=(const ColaPrioridadNoticias&) = delete;
+
+    /// @brief Verifica si la cola está vacía.
+    /// @return true si la cola está vacía, false en caso contrario.
+    bool estaVacia() const {
+        return cantidad == 0;
+    }
+
+    /// @brief Número de noticias en la cola.
+    size_t tamano() const { return cantidad; }
+
+    /**
+     * @brief Inserta una noticia en la cola de prioridad según su impacto. O(log n) amortizado.
+     * @param impacto Nivel de impacto de la noticia.
+     * @param titulo Título de la noticia (se interna: no hace falta que siga vivo).
+     * @param descripcion Descripción de la noticia (ídem).
+     * @param sector Sector afectado (ídem).
+     * @param fecha Fecha de la noticia.
+     * @param esPositiva true si la noticia es positiva, false si es negativa.
+     */
+    void insertar(int impacto, string_view titulo, string_view descripcion, string_view sector, Fecha fecha, bool esPositiva = true) {
+        if (textos.cantidad() > 6 * cantidad + TEXTOS_LIBRES) compactarTextos();
+        Noticia* nueva = nodos.crear(impacto, textos.internar(titulo), textos.internar(descripcion), textos.internar(sector),
+                                     fecha, esPositiva);
+        indice.agregar(nueva);  // Asigna el número de inserción, que desempata en el índice cronológico
+        porFecha.insertar({fecha, impacto, nueva});
+        porImpacto[impacto].push_back(nueva);
+        detector.registrar(nueva, &alertas);
+        cantidad++;
+        sumaImpacto += impacto;
+    }
+
+    /// @brief Iterador a la noticia de mayor prioridad (recorrido en orden de prioridad).
+    IteradorPrioridad begin() const { return IteradorPrioridad(porImpacto.begin(), porImpacto.end()); }
+    /// @brief Iterador de fin.
+    IteradorPrioridad end() const { return IteradorPrioridad(porImpacto.end(), porImpacto.end()); }
+
+    /// @brief Todas las noticias en orden cronológico. O(1); recorrerla es O(n).
+    RangoNoticias porOrdenDeFecha() const {
+        return RangoNoticias(porFecha.begin(), porFecha.end());
+    }
+
+    /**
+     * @brief Noticias con fecha en [desde, hasta], en orden cronológico. O(log n + k).
+     * @param desde Fecha inicial (inclusive).
+     * @param hasta Fecha final (inclusive).
+     */
+    RangoNoticias entreFechas(Fecha desde, Fecha hasta) const {
+        if (hasta < desde) return RangoNoticias(porFecha.end(), porFecha.end());
+        return RangoNoticias(porFecha.desde(desde), porFecha.despuesDe(hasta));
+    }
+
+    /// @brief Muestra todas las noticias en la cola, en orden de prioridad.
+    void mostrar() const {
+        for (Noticia* actual : *this) mostrarNoticia(actual);
+    }
+
+    /// @brief Muestra todas las noticias en orden cronológico, sin alterar la cola.
+    void mostrarPorFecha() const {
+        for (Noticia* actual : porOrdenDeFecha()) mostrarNoticia(actual);
+    }
+
+    /**
+     * @brief Muestra las noticias de un rango de fechas, en orden cronológico.
+     * @param desde Fecha inicial (inclusive).
+     * @param hasta Fecha final (inclusive).
+     */
+    void mostrarEntreFechas(Fecha desde, Fecha hasta) const {
+        RangoNoticias rango = entreFechas(desde, hasta);
+        if (rango.empty()) cout << "No hay noticias entre " << desde << " y " << hasta << ".\n";
+        for (Noticia* actual : rango) mostrarNoticia(actual);
+    }
+
+    /**
+     * @brief Noticias de un sector (sin distinguir mayúsculas ni tildes). O(k).
+     * @param sector Nombre del sector.
+     * @return Noticias del sector, en orden de inserción.
+     */
+    vector<Noticia*> noticiasDeSector(const string& sector) const { return indice.buscarSector(sector); }
+
+    /**
+     * @brief Noticias cuyo título o descripción contiene las palabras de la consulta.
+     * @param consulta Palabras a buscar (sin distinguir mayúsculas ni tildes).
+     * @param todas true para exigir todas las palabras (AND), false para aceptar cualquiera (OR).
+     * @param prefijo true para aceptar palabras que empiecen como cada término.
+     * @return Noticias encontradas, en orden de inserción.
+     */
+    vector<Noticia*> buscarPalabras(const string& consulta, bool todas = true, bool prefijo = false) const {
+        return indice.buscar(consulta, todas, prefijo);
+    }
+
+    /**
+     * @brief Ordena un resultado de búsqueda por prioridad, para mostrarlo.
+     * @param noticias Noticias a ordenar.
+     */
+    static void ordenarPorPrioridad(vector<Noticia*>& noticias) {
+        sort(noticias.begin(), noticias.end(), [](const Noticia* a, const Noticia* b) {
+            return a->impacto > b->impacto || (a->impacto == b->impacto && a->orden < b->orden);
+        });
+    }
+
+    /**
+     * @brief Busca y muestra noticias que pertenecen a un sector específico, por prioridad.
+     * @param sectorClave Nombre del sector a buscar.
+     */
+    void buscarPorSector(const string& sectorClave) const {
+        vector<Noticia*> encontradas = noticiasDeSector(sectorClave);
+        ordenarPorPrioridad(encontradas);
+        cout << "\n🔍 Noticias en el sector '" << sectorClave << "':\n";
+        for (Noticia* actual : encontradas) {
+            cout << "- " << actual->titulo << " (Impacto: " << actual->impacto << ")\n";
         }
     }
 
     /**
-     * @brief Aplica el algoritmo Merge Sort recursivamente para ordenar por fecha.
-     * @param cabeza Puntero al inicio de la lista a ordenar.
-     * @return Puntero al inicio de la lista ordenada.
+     * @brief Busca y muestra, por prioridad, noticias con palabras que empiecen como las de la consulta.
+     * @param consulta Palabras clave.
+     * @param todas true si deben aparecer todas las palabras, false si basta con una.
      */
-    Noticia* mergeSort(Noticia* cabeza) {
-        if (!cabeza || !cabeza->siguiente) return cabeza;
+    void buscarPorPalabraClave(const string& consulta, bool todas = true) const {
+        vector<Noticia*> encontradas = buscarPalabras(consulta, todas, true);
+        ordenarPorPrioridad(encontradas);
+        cout << "\n🔍 Noticias con '" << consulta << "' en el título o la descripción:\n";
+        for (Noticia* actual : encontradas) {
+            cout << "- " << actual->titulo << " (" << actual->sectorAfectado << ")\n";
+        }
+    }
 
-        Noticia* mitad = dividir(cabeza);
-        Noticia* izquierda = mergeSort(cabeza);
-        Noticia* derecha = mergeSort(mitad);
+    /// @brief Detecta si algún sector está en alerta de crisis en las ventanas actuales. O(sectores).
+    /// @return true si hay alerta de crisis, false en caso contrario.
+    bool hayAlertaDeCrisis() {
+        return !detector.sectoresEnAlerta().empty();
+    }
 
-        return fusionar(izquierda, derecha);
+    /// @brief Detector de crisis por sector (para consultar ventanas o configurar umbrales).
+    DetectorCrisis& detectorCrisis() { return detector; }
+    /// @brief Detector de crisis por sector (solo consulta).
+    const DetectorCrisis& detectorCrisis() const { return detector; }
+
+    /**
+     * @brief Entrega las alertas emitidas desde la última llamada y las olvida.
+     * @return Alertas en el orden en que se dispararon.
+     */
+    vector<AlertaCrisis> tomarAlertas() {
+        vector<AlertaCrisis> pendientes;
+        pendientes.swap(alertas);
+        return pendientes;
     }
 
-    /// @brief Ordena toda la cola de noticias cronológicamente por fecha.
-    void ordenarPorFecha() {
-        frente = mergeSort(frente);
-        cout << "\n📆 Noticias ordenadas por fecha.\n";
+    /// @brief Calcula el promedio del impacto de todas las noticias en la cola. O(1).
+    /// @return Promedio del impacto (float).
+    float promedioImpacto() const {
+        if (estaVacia()) return 0;
+        return (float)sumaImpacto / cantidad;
     }
 
-    /// @brief Destructor. Libera la memoria de todas las noticias en la cola.
-    ~ColaPrioridadNoticias() {
-        while (!estaVacia()) {
-            Noticia* temp = extraer();
-            delete temp;
+    /**
+     * @brief Extrae la noticia con mayor prioridad (mayor impacto).
+     * @param salida Noticia extraída, con copias propias de sus textos.
+     * @return false si la cola está vacía.
+     */
+    bool extraer(NoticiaExtraida& salida) {
+        if (estaVacia()) return false;
+
+        auto grupo = porImpacto.begin();
+        Noticia* primera = grupo->second.front();
+        grupo->second.pop_front();
+        if (grupo->second.empty()) porImpacto.erase(grupo);
+        porFecha.quitar({primera->fecha, primera->impacto, primera});  // Antes de que el índice renumere
+        indice.quitar(primera);
+        detector.retirar(primera);
+        cantidad--;
+        sumaImpacto -= primera->impacto;
+        salida.impacto = primera->impacto;
+        salida.titulo.assign(primera->titulo);
+        salida.descripcion.assign(primera->descripcion);
+        salida.sectorAfectado.assign(primera->sectorAfectado);
+        salida.fecha = primera->fecha;
+        salida.esPositiva = primera->esPositiva;
+        nodos.liberar(primera);
+        return true;
+    }
+
+    /// @brief Llena un vector con punteros a todas las noticias de la cola, en orden de prioridad.
+    void obtenerNoticias(vector<Noticia*>& noticias) const {
+        noticias.reserve(noticias.size() + cantidad);
+        for (Noticia* actual : *this) noticias.push_back(actual);
+    }
+
+    /**
+     * @brief Llena un vector con las noticias en orden cronológico, sin alterar la cola.
+     *        Las noticias de una misma fecha quedan en orden de prioridad.
+     */
+    void obtenerNoticiasPorFecha(vector<Noticia*>& noticias) const {
+        noticias.reserve(noticias.size() + cantidad);
+        for (Noticia* actual : porOrdenDeFecha()) noticias.push_back(actual);
+    }
+
+    /// @brief Textos distintos guardados (títulos, descripciones y sectores).
+    const TablaTextos& tablaTextos() const { return textos; }
+
+    /**
+     * @brief Escribe los umbrales de crisis y las noticias en orden de prioridad (ver SnapshotMercado).
+     * @param salida Escritor binario.
+     */
+    void guardar(EscritorBinario& salida) const {
+        detector.guardarUmbrales(salida);
+        for (const Noticia* n : *this) {
+            salida.valor<int32_t>(n->impacto);
+            salida.texto(n->titulo);
+            salida.texto(n->descripcion);
+            salida.texto(n->sectorAfectado);
+            salida.valor(n->fecha.dias);
+            salida.valor<uint8_t>(n->esPositiva);
+        }
+    }
+
+    /**
+     * @brief Lee los umbrales y las noticias escritos por guardar() e inserta las noticias.
+     *
+     * Los umbrales se configuran antes de insertar, así que las ventanas de
+     * crisis quedan como en la sesión guardada.
+     * Como las noticias vienen en orden de prioridad, cada una va al final de su grupo de
+     * impacto y el orden entre empates se conserva. Los textos se internan
+     * directamente desde la entrada, sin copias intermedias.
+     * @param entrada Lector; si se acaba antes de tiempo queda inválido.
+     * @param numNoticias Noticias a leer.
+     */
+    void cargar(LectorBinario& entrada, uint64_t numNoticias) {
+        detector.cargarUmbrales(entrada);
+        for (uint64_t k = 0; k < numNoticias && entrada.correcto(); ++k) {
+            int impacto = entrada.valor<int32_t>();
+            string_view titulo = entrada.vistaTexto();
+            string_view descripcion = entrada.vistaTexto();
+            string_view sector = entrada.vistaTexto();
+            Fecha fecha(entrada.valor<int32_t>());
+            bool esPositiva = entrada.valor<uint8_t>() != 0;
+            if (entrada.correcto()) insertar(impacto, titulo, descripcion, sector, fecha, esPositiva);
         }
     }
 };
@@ -254,40 +1209,69 @@ public:
 // ======== GENERADOR DE NOTICIAS ALEATORIAS ========
 
 /**
- * @brief Genera un string de fecha con formato "YYYY-MM-DD" a partir de un número de días desde el inicio.
+ * @brief Genera una fecha a partir de un número de días desde el inicio.
  * @param diasDesdeInicio Número de días a sumar al día base (1 de mayo de 2025).
- * @return Fecha en formato "YYYY-MM-DD".
+ * @return Fecha resultante (los años bisiestos se respetan).
  */
-string generarFecha(int diasDesdeInicio = 0) {
-    int year = 2025;
-    int month = 5;
-    int day = 1 + diasDesdeInicio;
-
-    // Ajustar el día y el mes si se pasa del final del mes
-    while (true) {
-        int diasMes;
-        if (month == 2) diasMes = 28;
-        else if (month == 4 || month == 6 || month == 9 || month == 11) diasMes = 30;
-        else diasMes = 31;
-        if (day > diasMes) {
-            day -= diasMes;
-            month++;
-            if (month > 12) {
-                month = 1;
-                year++;
-            }
-        } else {
-            break;
-        }
-    }
+inline Fecha generarFecha(int diasDesdeInicio = 0) {
+    return Fecha::desdeCivil(2025, 5, 1) + diasDesdeInicio;
+}
+
+/// @brief Títulos posibles de las noticias generadas.
+const vector<string> TITULOS_NOTICIA = {
+    "Caída del dólar", "Nuevo impuesto", "Reforma pensional", "Crisis energética",
+    "Inversión extranjera", "Caída de acciones tecnológicas", "Sube el petróleo",
+    "Aumento del salario mínimo", "Devaluación del peso", "Acuerdo comercial firmado"
+};
+
+/// @brief Descripciones posibles de las noticias generadas.
+const vector<string> DESCRIPCIONES_NOTICIA = {
+    "Los mercados reaccionan ante la noticia.",
+    "Expertos prevén cambios importantes en el comportamiento bursátil.",
+    "Los sectores económicos muestran señales de volatilidad.",
+    "Los analistas recomiendan cautela a los inversionistas.",
+    "Impacto inmediato esperado en el mercado accionario."
+};
+
+/**
+ * @brief Noticia generada aleatoriamente; los textos son índices en las tablas globales.
+ */
+struct NoticiaGenerada {
+    int impacto;      ///< Nivel de impacto de 1 a 10
+    int titulo;       ///< Índice en TITULOS_NOTICIA
+    int descripcion;  ///< Índice en DESCRIPCIONES_NOTICIA
+    int sector;       ///< Índice en SECTORES_EMPRESA
+    Fecha fecha;      ///< Fecha de la noticia
+    bool esPositiva;  ///< Indica si la noticia es positiva
+};
 
-    string fecha = "";
-    fecha += to_string(year) + "-";
-    if (month < 10) fecha += "0";
-    fecha += to_string(month) + "-";
-    if (day < 10) fecha += "0";
-    fecha += to_string(day);
-    return fecha;
+/**
+ * @brief Genera un lote de noticias aleatorias reproducible a partir de una semilla.
+ *
+ * La noticia i usa su propio flujo aleatorio (semilla, i), así que el lote es
+ * el mismo con cualquier número de hilos.
+ * @param cantidad Número de noticias a generar.
+ * @param semilla Semilla del lote.
+ * @param hilos Número de hilos de generación.
+ * @return Noticias generadas, una por día desde el 1 de mayo de 2025.
+ */
+inline vector<NoticiaGenerada> generarLoteNoticias(int cantidad, uint64_t semilla, unsigned hilos = hilosDisponibles()) {
+    vector<NoticiaGenerada> lote(cantidad > 0 ? cantidad : 0);
+    if (lote.empty()) return lote;
+    if (hilos > lote.size()) hilos = lote.size();
+    ejecutarEnParalelo(hilos, [&](unsigned h) {
+        for (size_t i = lote.size() * h / hilos; i < lote.size() * (h + 1) / hilos; ++i) {
+            GeneradorAleatorio flujo(semilla, i);
+            NoticiaGenerada& n = lote[i];
+            n.impacto = flujo.entero(1, 10);
+            n.titulo = flujo.menorQue(TITULOS_NOTICIA.size());
+            n.descripcion = flujo.menorQue(DESCRIPCIONES_NOTICIA.size());
+            n.sector = flujo.menorQue(SECTORES_EMPRESA.size());
+            n.fecha = generarFecha(i);  // Avanza un día por noticia
+            n.esPositiva = flujo.menorQue(2) == 0;
+        }
+    });
+    return lote;
 }
 
 /**
@@ -296,36 +1280,44 @@ string generarFecha(int diasDesdeInicio = 0) {
  * @param cantidad Número de noticias a generar.
  * @param semilla Semilla para el generador aleatorio (por defecto 1234).
  */
-void generarNoticiasAleatorias(ColaPrioridadNoticias& cola, int cantidad, int semilla = 1234) {
-    srand(semilla);  // Semilla reproducible
-
-    vector<string> titulos = {
-        "Caída del dólar", "Nuevo impuesto", "Reforma pensional", "Crisis energética",
-        "Inversión extranjera", "Caída de acciones tecnológicas", "Sube el petróleo",
-        "Aumento del salario mínimo", "Devaluación del peso", "Acuerdo comercial firmado"
-    };
-
-    vector<string> descripciones = {
-        "Los mercados reaccionan ante la noticia.",
-        "Expertos prevén cambios importantes en el comportamiento bursátil.",
-        "Los sectores económicos muestran señales de volatilidad.",
-        "Los analistas recomiendan cautela a los inversionistas.",
-        "Impacto inmediato esperado en el mercado accionario."
-    };
-
-    // Usa los sectores globales de empresa.h
-    for (int i = 0; i < cantidad; ++i) {
-        int impacto = rand() % 10 + 1;
-        string titulo = titulos[rand() % titulos.size()];
-        string descripcion = descripciones[rand() % descripciones.size()];
-        string sector = SECTORES_EMPRESA[rand() % SECTORES_EMPRESA.size()];
-        string fecha = generarFecha(i);  // Avanza un día por noticia
-        bool esPositiva = rand() % 2 == 0; // Aleatorio: true o false
-
-        cola.insertar(impacto, titulo, descripcion, sector, fecha, esPositiva);
+void generarNoticiasAleatorias(ColaPrioridadNoticias& cola, int cantidad, uint64_t semilla = 1234) {
+    for (const NoticiaGenerada& n : generarLoteNoticias(cantidad, semilla)) {
+        cola.insertar(n.impacto, TITULOS_NOTICIA[n.titulo], DESCRIPCIONES_NOTICIA[n.descripcion],
+                      SECTORES_EMPRESA[n.sector], n.fecha, n.esPositiva);
     }
 }
 
+/**
+ * @brief Simula días hábiles de mercado con noticias aleatorias diarias.
+ *
+ * Cada día genera su lote de noticias con el flujo
+ * (semilla ^ hashTexto("noticias-dia"), día), independiente de los que usan
+ * generarMercado y simularDias con la misma semilla; las inserta en la cola
+ * con la fecha del día y deja que ABBEmpresas::simularDias las aplique junto
+ * con el paso diario de precios, repartiendo las empresas entre los hilos del
+ * grupo. El resultado es el mismo con cualquier número de hilos.
+ * @param arbol Mercado a simular.
+ * @param cola Cola donde se insertan las noticias generadas.
+ * @param desde Primer día (si no es hábil, el lunes siguiente).
+ * @param dias Días hábiles a simular.
+ * @param noticiasPorDia Noticias aleatorias por día (0 = solo el paso de precios).
+ * @param semilla Semilla de la simulación.
+ * @param grupo Hilos de trabajo, reutilizados todos los días.
+ */
+inline void simularMercado(ABBEmpresas& arbol, ColaPrioridadNoticias& cola, Fecha desde, int dias, int noticiasPorDia,
+                           uint64_t semilla, GrupoHilos& grupo) {
+    arbol.simularDias(desde, dias, semilla, grupo, [&](Fecha dia, vector<AjusteNoticia>& lote) {
+        if (noticiasPorDia <= 0) return;
+        GeneradorAleatorio semillaDia(semilla ^ hashTexto("noticias-dia"), (uint64_t)dia.dias);
+        for (const NoticiaGenerada& n : generarLoteNoticias(noticiasPorDia, semillaDia(), 1)) {
+            const string& sector = SECTORES_EMPRESA[n.sector];
+            cola.insertar(n.impacto, TITULOS_NOTICIA[n.titulo], DESCRIPCIONES_NOTICIA[n.descripcion], sector, dia,
+                          n.esPositiva);
+            lote.push_back({sector, n.impacto, dia});
+        }
+    });
+}
+
 /**
  * @brief Muestra el ajuste aplicado a los precios de un sector.
  * @param sector Sector afectado.
@@ -341,6 +1333,40 @@ inline void mostrarAjusteSector(const string& sector, float porcentaje) {
         cout << "Sin cambio\n";
 }
 
+/**
+ * @brief Muestra las alertas de crisis recién emitidas.
+ * @param alertas Alertas a mostrar.
+ * @param detector Detector que las emitió (para nombrar las ventanas).
+ */
+inline void mostrarAlertasCrisis(const vector<AlertaCrisis>& alertas, const DetectorCrisis& detector) {
+    for (const AlertaCrisis& a : alertas) {
+        cout << "  ALERTA [" << a.fecha << "] sector '" << a.estado.sector << "': ";
+        if (a.porVentanaCorta)
+            cout << a.estado.altasCorta << " noticias de impacto >= " << detector.impactoDeAlerta()
+                 << " en " << detector.diasVentanaCorta() << " días hábiles\n";
+        else
+            cout << "impacto acumulado " << a.estado.sumaLarga << " en " << detector.diasVentanaLarga()
+                 << " días hábiles\n";
+    }
+}
+
+/**
+ * @brief Muestra las ventanas de crisis de todos los sectores con noticias recientes.
+ * @param detector Detector de crisis.
+ */
+inline void mostrarVentanasCrisis(DetectorCrisis& detector) {
+    if (detector.vacio()) return;
+    cout << "Ventanas al " << detector.fechaActual() << " (" << detector.diasVentanaCorta() << " y "
+         << detector.diasVentanaLarga() << " días hábiles):\n";
+    for (const EstadoCrisisSector& e : detector.estados()) {
+        if (e.noticiasLarga == 0) continue;
+        UmbralCrisis u = detector.umbral(e.sector);
+        cout << "  " << e.sector << ": " << e.altasCorta << "/" << u.altasVentanaCorta << " de alto impacto, promedio "
+             << e.promedioCorta() << " | " << e.sumaLarga << "/" << u.sumaVentanaLarga << " de impacto acumulado, promedio "
+             << e.promedioLarga() << (e.enAlerta ? "  <-- ALERTA" : "") << "\n";
+    }
+}
+
 /**
  * @brief Calcula el porcentaje de ajuste según el impacto.
  * @param impacto Impacto de la noticia (1-10).
@@ -353,6 +1379,65 @@ inline float calcularPorcentajeAjuste(int impacto) {
         return -(6 - impacto) * 0.01;
 }
 
+/**
+ * @brief Fila de la tabla de impacto: precio de una empresa afectada antes y en la fecha de una noticia.
+ */
+struct FilaImpactoNoticia {
+    const Noticia* noticia;  ///< Noticia
+    Empresa* empresa;        ///< Empresa del sector afectado
+    float precioAntes;       ///< Último precio anterior a la fecha de la noticia (si hayAntes)
+    float precioDespues;     ///< Precio registrado en la fecha de la noticia
+    bool hayAntes;           ///< Indica si hay un precio anterior
+
+    /// @brief Cambio absoluto (0 sin precio anterior).
+    float cambio() const { return hayAntes ? precioDespues - precioAntes : 0; }
+    /// @brief Cambio porcentual (0 sin precio anterior).
+    float porcentaje() const { return hayAntes && precioAntes != 0 ? cambio() / precioAntes * 100.0f : 0.0f; }
+};
+
+/**
+ * @brief Calcula la tabla de impacto noticia x empresa afectada en una sola pasada.
+ *
+ * Las empresas se obtienen una vez por sector (no por noticia) y cada precio
+ * se busca en el índice por fecha del historial en O(log h), así que la tabla
+ * cuesta O(filas · log h) en vez de O(noticias · empresas · h).
+ * @param arbol Árbol de empresas.
+ * @param noticias Noticias, en el orden que deben seguir las filas.
+ * @param soloEmpresa Si no es nullptr, solo se calculan las filas de esa empresa.
+ * @return Filas de las empresas con precio en la fecha de la noticia, agrupadas por noticia.
+ */
+inline vector<FilaImpactoNoticia> tablaImpactoNoticias(const ABBEmpresas& arbol, const vector<Noticia*>& noticias,
+                                                             Empresa* soloEmpresa = nullptr) {
+    vector<FilaImpactoNoticia> filas;
+    // Los sectores de las noticias están internados: se reconocen por dirección
+    unordered_map<const char*, const vector<Empresa*>*> empresasDeSector;
+    vector<Empresa*> unaEmpresa;
+    if (soloEmpresa) unaEmpresa.push_back(soloEmpresa);
+    for (const Noticia* noticia : noticias) {
+        const vector<Empresa*>* empresas = &unaEmpresa;
+        if (soloEmpresa) {
+            if (soloEmpresa->sector != noticia->sectorAfectado) continue;
+        } else {
+            auto it = empresasDeSector.find(noticia->sectorAfectado.data());
+            if (it == empresasDeSector.end()) {
+                it = empresasDeSector.emplace(noticia->sectorAfectado.data(),
+                                              &arbol.obtenerEmpresasPorSector(string(noticia->sectorAfectado))).first;
+            }
+            empresas = it->second;
+        }
+        for (Empresa* e : *empresas) {
+            FilaImpactoNoticia fila;
+            fila.noticia = noticia;
+            fila.empresa = e;
+            if (!e->historialPrecios.precioEnFecha(noticia->fecha, fila.precioDespues)) continue;
+            fila.hayAntes = e->historialPrecios.precioAntesDe(noticia->fecha, fila.precioAntes);
+            if (!fila.hayAntes) fila.precioAntes = 0;
+            filas.push_back(fila);
+        }
+    }
+    return filas;
+}
+
 /**
  * @brief Muestra los cambios de precio de una empresa por cada noticia que la afectó, mostrando el precio antes y después para cada fecha de noticia.
  * @param arbol Árbol de empresas.
@@ -373,44 +1458,28 @@ inline void mostrarCambiosPorNoticiasEmpresa(ABBEmpresas& arbol, ColaPrioridadNo
     cout << "\n================= CAMBIOS DE " << emp->nombre << " (" << emp->ticker << ") POR NOTICIAS =================\n";
     cout << " Fecha       | Título de la noticia                | Precio antes | Precio después | Cambio | Cambio (%)\n";
     cout << "--------------------------------------------------------------------------------------------------------\n";
-    for (auto noticia : noticias) {
-        if (emp->sector == noticia->sectorAfectado) {
-            NodoPrecio* p = emp->historialPrecios.cabeza;
-            float precioEnFecha = -1, precioAnterior = -1;
-            string fechaAnterior = "";
-            while (p) {
-                if (p->fecha == noticia->fecha) {
-                    precioEnFecha = p->precioCierre;
-                } else if (p->fecha < noticia->fecha) {
-                    if (fechaAnterior == "" || p->fecha > fechaAnterior) {
-                        precioAnterior = p->precioCierre;
-                        fechaAnterior = p->fecha;
-                    }
-                }
-                p = p->siguiente;
-            }
-            if (precioEnFecha >= 0 && precioAnterior >= 0) {
-                // Fecha
-                cout << noticia->fecha << " | ";
-                // Título (máx 32)
-                int n = 0;
-                for (; n < 32 && noticia->titulo[n] != '\0'; ++n) cout << noticia->titulo[n];
-                for (; n < 32; ++n) cout << " ";
-                cout << " | ";
-                // Precio antes
-                cout << precioAnterior << "      | ";
-                // Precio después
-                cout << precioEnFecha << "        | ";
-                // Cambio absoluto
-                float cambio = precioEnFecha - precioAnterior;
-                float porcentaje = (precioAnterior != 0) ? (cambio / precioAnterior) * 100.0f : 0.0f;
-                if (cambio > 0) cout << "+";
-                cout << cambio << "    | ";
-                if (porcentaje > 0) cout << "+";
-                cout << porcentaje << "%\n";
-                alguna = true;
-            }
-        }
+    for (const FilaImpactoNoticia& fila : tablaImpactoNoticias(arbol, noticias, emp)) {
+        if (!fila.hayAntes) continue;
+        const Noticia* noticia = fila.noticia;
+        // Fecha
+        cout << noticia->fecha << " | ";
+        // Título (máx 32)
+        int n = 0;
+        for (; n < 32 && n < (int)noticia->titulo.size(); ++n) cout << noticia->titulo[n];
+        for (; n < 32; ++n) cout << " ";
+        cout << " | ";
+        // Precio antes
+        cout << fila.precioAntes << "      | ";
+        // Precio después
+        cout << fila.precioDespues << "        | ";
+        // Cambio absoluto
+        float cambio = fila.cambio();
+        float porcentaje = fila.porcentaje();
+        if (cambio > 0) cout << "+";
+        cout << cambio << "    | ";
+        if (porcentaje > 0) cout << "+";
+        cout << porcentaje << "%\n";
+        alguna = true;
     }
     if (!alguna) {
         cout << "No hay noticias que hayan afectado a esta empresa.\n";
@@ -430,6 +1499,8 @@ inline void mostrarImpactoNoticiasEnAcciones(ABBEmpresas& arbol, ColaPrioridadNo
         cout << "No hay noticias registradas.\n";
         return;
     }
+    vector<FilaImpactoNoticia> filas = tablaImpactoNoticias(arbol, noticias);
+    size_t siguiente = 0;
     cout << "\n================= IMPACTO DE NOTICIAS EN EMPRESAS =================\n";
     for (auto actual : noticias) {
         cout << "\n---------------------------------------------------------------\n";
@@ -437,53 +1508,34 @@ inline void mostrarImpactoNoticiasEnAcciones(ABBEmpresas& arbol, ColaPrioridadNo
         cout << "---------------------------------------------------------------\n";
         cout << " Ticker   | Precio antes | Precio después | Cambio absoluto | Cambio (%)\n";
         cout << "---------------------------------------------------------------\n";
-        vector<Empresa*> empresas = arbol.obtenerEmpresasOrdenadas();
         bool alguna = false;
-        for (auto e : empresas) {
-            if (e->sector == actual->sectorAfectado) {
-                NodoPrecio* p = e->historialPrecios.cabeza;
-                float precioEnFecha = -1, precioAnterior = -1;
-                string fechaAnterior = "";
-                while (p) {
-                    if (p->fecha == actual->fecha) {
-                        precioEnFecha = p->precioCierre;
-                    } else if (p->fecha < actual->fecha) {
-                        if (fechaAnterior == "" || p->fecha > fechaAnterior) {
-                            precioAnterior = p->precioCierre;
-                            fechaAnterior = p->fecha;
-                        }
-                    }
-                    p = p->siguiente;
-                }
-                if (precioEnFecha >= 0 && precioAnterior >= 0) {
-                    float cambio = precioEnFecha - precioAnterior;
-                    float porcentaje = (precioAnterior != 0) ? (cambio / precioAnterior) * 100.0f : 0.0f;
-                    // Ticker (máx 8)
-                    int t = 0;
-                    cout << " ";
-                    for (; t < 8 && e->ticker[t] != '\0'; ++t) cout << e->ticker[t];
-                    for (; t < 8; ++t) cout << " ";
-                    cout << " | ";
-                    // Precio antes
-                    cout << precioAnterior << "      | ";
-                    // Precio después
-                    cout << precioEnFecha << "        | ";
-                    // Cambio absoluto
-                    if (cambio > 0) cout << "+";
-                    cout << cambio << "         | ";
-                    // Cambio porcentual
-                    if (porcentaje > 0) cout << "+";
-                    cout << porcentaje << "%\n";
-                    alguna = true;
-                } else if (precioEnFecha >= 0) {
-                    int t = 0;
-                    cout << " ";
-                    for (; t < 8 && e->ticker[t] != '\0'; ++t) cout << e->ticker[t];
-                    for (; t < 8; ++t) cout << " ";
-                    cout << " | N/A         | " << precioEnFecha << "        | N/A           | N/A\n";
-                    alguna = true;
-                }
+        // Las filas vienen agrupadas en el mismo orden que las noticias
+        for (; siguiente < filas.size() && filas[siguiente].noticia == actual; ++siguiente) {
+            const FilaImpactoNoticia& fila = filas[siguiente];
+            // Ticker (máx 8)
+            const string& ticker = fila.empresa->ticker;
+            int t = 0;
+            cout << " ";
+            for (; t < 8 && t < (int)ticker.size(); ++t) cout << ticker[t];
+            for (; t < 8; ++t) cout << " ";
+            if (fila.hayAntes) {
+                float cambio = fila.cambio();
+                float porcentaje = fila.porcentaje();
+                cout << " | ";
+                // Precio antes
+                cout << fila.precioAntes << "      | ";
+                // Precio después
+                cout << fila.precioDespues << "        | ";
+                // Cambio absoluto
+                if (cambio > 0) cout << "+";
+                cout << cambio << "         | ";
+                // Cambio porcentual
+                if (porcentaje > 0) cout << "+";
+                cout << porcentaje << "%\n";
+            } else {
+                cout << " | N/A         | " << fila.precioDespues << "        | N/A           | N/A\n";
             }
+            alguna = true;
         }
         if (!alguna) cout << "  No hubo empresas afectadas en ese sector.\n";
     }
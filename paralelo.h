@@ -0,0 +1,148 @@
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Número de hilos a usar por defecto (núcleos disponibles, al menos 1).
+ * @return Cantidad de hilos.
+ */
+inline unsigned hilosDisponibles() {
+    unsigned n = thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+/**
+ * @brief Reparte una secuencia de tareas con peso en tramos contiguos de peso similar.
+ * @param pesos Peso (costo estimado) de cada tarea, en orden.
+ * @param partes Número de tramos deseados (al menos 1).
+ * @return Vector de partes + 1 cortes: el tramo p es [cortes[p], cortes[p + 1]).
+ */
+inline vector<size_t> repartirPorPeso(const vector<size_t>& pesos, unsigned partes) {
+    if (partes == 0) partes = 1;
+    size_t total = 0;
+    for (size_t p : pesos) total += p;
+    vector<size_t> cortes(partes + 1, pesos.size());
+    cortes[0] = 0;
+    size_t acumulado = 0, i = 0;
+    for (unsigned p = 1; p < partes; ++p) {
+        // Avanzar hasta que el tramo p-1 alcance su parte proporcional del peso
+        size_t objetivo = total * p / partes;
+        while (i < pesos.size() && acumulado + pesos[i] <= objetivo) acumulado += pesos[i++];
+        cortes[p] = i;
+    }
+    return cortes;
+}
+
+/**
+ * @brief Ejecuta una función en varios hilos y espera a que todos terminen.
+ *
+ * El hilo que llama ejecuta el tramo 0, de modo que con un solo hilo no se
+ * crea ningún hilo nuevo.
+ * @param hilos Número de hilos (al menos 1).
+ * @param tarea Función invocada como tarea(indiceHilo) en cada hilo.
+ */
+template <typename F>
+void ejecutarEnParalelo(unsigned hilos, F tarea) {
+    if (hilos == 0) hilos = 1;
+    vector<thread> trabajadores;
+    trabajadores.reserve(hilos - 1);
+    for (unsigned h = 1; h < hilos; ++h) trabajadores.emplace_back(tarea, h);
+    tarea(0u);
+    for (thread& t : trabajadores) t.join();
+}
+
+/**
+ * @brief Grupo de hilos persistente para ejecutar muchas rondas cortas.
+ *
+ * A diferencia de ejecutarEnParalelo, los hilos se crean una sola vez y
+ * esperan entre rondas, así que cada ronda cuesta una notificación y no una
+ * creación de hilos. Cada llamada a ejecutar() es una barrera: vuelve cuando
+ * todos los hilos terminaron su parte. Como en ejecutarEnParalelo, el hilo
+ * que llama ejecuta la parte 0.
+ */
+class GrupoHilos {
+private:
+    vector<thread> trabajadores;     ///< Hilos 1..n-1 (el 0 es el que llama)
+    mutex cerrojo;                   ///< Protege el estado de la ronda
+    condition_variable hayRonda;     ///< Avisa a los trabajadores de una ronda nueva o del cierre
+    condition_variable rondaLista;   ///< Avisa al que llama de que todos terminaron
+    void (*llamar)(void*, unsigned); ///< Invoca la tarea de la ronda
+    void* tarea;                     ///< Tarea de la ronda (vive en la pila de ejecutar)
+    uint64_t ronda;                  ///< Número de la ronda actual
+    unsigned pendientes;             ///< Trabajadores que aún no terminan la ronda
+    bool cerrando;                   ///< true cuando el grupo se destruye
+
+    /// @brief Bucle de un trabajador: espera una ronda, ejecuta su parte y avisa.
+    void trabajar(unsigned h) {
+        uint64_t vista = 0;
+        unique_lock<mutex> bloqueo(cerrojo);
+        while (true) {
+            hayRonda.wait(bloqueo, [&] { return cerrando || ronda != vista; });
+            if (cerrando) return;
+            vista = ronda;
+            bloqueo.unlock();
+            llamar(tarea, h);
+            bloqueo.lock();
+            if (--pendientes == 0) rondaLista.notify_one();
+        }
+    }
+
+public:
+    /**
+     * @brief Crea el grupo y sus hilos.
+     * @param hilos Número de hilos, contando el que llama (al menos 1).
+     */
+    explicit GrupoHilos(unsigned hilos = hilosDisponibles())
+        : llamar(nullptr), tarea(nullptr), ronda(0), pendientes(0), cerrando(false) {
+        if (hilos == 0) hilos = 1;
+        trabajadores.reserve(hilos - 1);
+        for (unsigned h = 1; h < hilos; ++h) trabajadores.emplace_back(&GrupoHilos::trabajar, this, h);
+    }
+
+    /// @brief Despierta a los trabajadores para que terminen y los espera.
+    ~GrupoHilos() {
+        {
+            lock_guard<mutex> bloqueo(cerrojo);
+            cerrando = true;
+        }
+        hayRonda.notify_all();
+        for (thread& t : trabajadores) t.join();
+    }
+
+    GrupoHilos(const GrupoHilos&) = delete;
+    GrupoHilos& operator=(const GrupoHilos&) = delete;
+
+    /// @brief Número de hilos, contando el que llama.
+    unsigned tamano() const { return trabajadores.size() + 1; }
+
+    /**
+     * @brief Ejecuta una ronda: tarea(h) en cada hilo h y espera a que todos terminen.
+     * @param tarea Función invocada como tarea(indiceHilo).
+     */
+    template <typename F>
+    void ejecutar(F tarea) {
+        if (trabajadores.empty()) {
+            tarea(0u);
+            return;
+        }
+        {
+            lock_guard<mutex> bloqueo(cerrojo);
+            this->tarea = &tarea;
+            llamar = [](void* t, unsigned h) { (*static_cast<F*>(t))(h); };
+            pendientes = trabajadores.size();
+            ronda++;
+        }
+        hayRonda.notify_all();
+        tarea(0u);
+        unique_lock<mutex> bloqueo(cerrojo);
+        rondaLista.wait(bloqueo, [&] { return pendientes == 0; });
+    }
+};
+
+#endif
@@ -3,7 +3,6 @@
 
 #include <iostream>
 #include <string>
-#include <cmath> // <-- Agrega esto para usar sqrt
 #include "empresa.h"
 #include "noticia.h"
 using namespace std;
@@ -158,9 +157,9 @@ private:
 public:
     Portafolio(string nombre) : nombreUsuario(nombre) {}
 
-    void agregarActivo(const string& activo) {
+    void agregarActivo(const string& activo, bool mostrar = true) {
         activos.miPush(activo);
-        cout << "Activo '" << activo << "' agregado." << endl;
+        if (mostrar) cout << "Activo '" << activo << "' agregado." << endl;
     }
 
     bool tieneActivo(const string& activo) const {
@@ -177,12 +176,12 @@ public:
                 cout << "- " << activos[i] << '\n';
     }
 
-    bool eliminarActivo(const string& activo) {
+    bool eliminarActivo(const string& activo, bool mostrar = true) {
         if (activos.eliminar(activo)) {
-            cout << "Activo '" << activo << "' eliminado." << endl;
+            if (mostrar) cout << "Activo '" << activo << "' eliminado." << endl;
             return true;
         }
-        cout << "Activo '" << activo << "' no encontrado." << endl;
+        if (mostrar) cout << "Activo '" << activo << "' no encontrado." << endl;
         return false;
     }
 
@@ -194,6 +193,9 @@ public:
         }
     }
 
+    /// @brief Nombre del usuario dueño del portafolio.
+    const string& obtenerNombre() const { return nombreUsuario; }
+
     // Nuevo método para obtener los activos como vector<string>
     vector<string> obtenerActivos() const {
         vector<string> v;
@@ -202,6 +204,21 @@ public:
         return v;
     }
 
+    /// @brief Escribe el nombre del usuario y sus activos (ver SnapshotMercado).
+    void guardar(EscritorBinario& salida) const {
+        salida.texto(nombreUsuario);
+        salida.valor<uint32_t>(activos.size());
+        for (int i = 0; i < activos.size(); ++i) salida.texto(activos[i]);
+    }
+
+    /// @brief Reemplaza el nombre y los activos por los escritos con guardar(); si la entrada se acaba queda inválida.
+    void cargar(LectorBinario& entrada) {
+        nombreUsuario = entrada.texto();
+        uint32_t numActivos = entrada.valor<uint32_t>();
+        while (!activos.empty()) activos.miPop();
+        for (uint32_t k = 0; k < numActivos && entrada.correcto(); ++k) activos.miPush(entrada.texto());
+    }
+
     // Árbol de decisión para recomendar compra de un activo
     // Usa tendencia de precios históricos y noticias del sector
     void recomendarCompra(const string& ticker, ABBEmpresas& arbol, ColaPrioridadNoticias& colaNoticias) {
@@ -210,8 +227,10 @@ public:
             cout << "No se encontró la empresa para el ticker '" << ticker << "'.\n";
             return;
         }
+        // Indicadores precalculados al agregar cada precio (ventana de 5 días)
+        const IndicadoresTecnicos& ind = emp->historialPrecios.indicadores();
         // 1. ¿Tendencia positiva? (precio actual > promedio últimos 5 días)
-        float prom5 = emp->historialPrecios.promedioMovil(5);
+        float prom5 = ind.media();
         bool tendenciaPositiva = emp->precioActual > prom5;
         cout << "Tendencia positiva (precio actual $" << emp->precioActual << " > promedio 5 días $" << prom5 << "): ";
         cout << (tendenciaPositiva ? "Sí" : "No") << endl;
@@ -235,19 +254,8 @@ public:
             }
         } else {
             // 3. ¿Volatilidad baja? (desviación estándar últimos 5 días < 3%)
-            float precios[5];
-            int count = 0;
-            NodoPrecio* p = emp->historialPrecios.cabeza;
-            while (p && count < 5) {
-                precios[count++] = p->precioCierre;
-                p = p->siguiente;
-            }
-            float media = 0;
-            for (int i = 0; i < count; ++i) media += precios[i];
-            if (count > 0) media /= count;
-            float var = 0;
-            for (int i = 0; i < count; ++i) var += (precios[i] - media) * (precios[i] - media);
-            float desv = (count > 0) ? sqrt(var / count) : 0;
+            float media = ind.media();
+            float desv = ind.desviacion();
             float desvPorc = (media > 0) ? (desv / media) * 100.0f : 0;
             bool volatilidadBaja = desvPorc < 3.0f;
             cout << "Volatilidad últimos 5 días: " << desvPorc << "% (" << (volatilidadBaja ? "Baja" : "Alta") << ")\n";
@@ -0,0 +1,184 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "empresa.h"
+#include "noticia.h"
+#include "portafolio.h"
+#include "memoria.h"
+using namespace std;
+
+/**
+ * @brief Instantánea binaria y versionada del estado completo del sistema.
+ *
+ * Guarda empresas, historiales, la cola de noticias, el portafolio y el
+ * presupuesto en una sola escritura secuencial. Formato (orden de bytes
+ * nativo, todo alineado a 64 bytes):
+ * - Cabecera de 128 bytes.
+ * - Bloques de historial (BloqueHistorial tal como está en memoria), contiguos
+ *   y en el orden de las empresas.
+ * - Metadatos: empresas en orden de ticker (textos y precio), estado de sus
+ *   historiales (registros e indicadores), umbrales de crisis, noticias en
+ *   orden de prioridad, presupuesto y portafolio.
+ *
+ * Al cargar, el archivo se proyecta en memoria con copia privada y los
+ * historiales apuntan directamente a sus bloques: no se interpreta ningún
+ * registro de precios. Agregar precios después solo copia las páginas tocadas.
+ */
+struct SnapshotMercado {
+    /// Versión del formato; cambia con cualquier cambio en la disposición de los datos
+    static const uint32_t VERSION = 3;
+
+    /// @brief Cabecera de la instantánea (128 bytes).
+    struct Cabecera {
+        char magia[8];             ///< "MERCSNAP"
+        uint32_t version;          ///< VERSION
+        uint32_t ordenBytes;       ///< 0x01020304 en el orden de bytes de quien escribió
+        uint32_t tamanoBloque;     ///< sizeof(BloqueHistorial)
+        uint32_t reservado;        ///< Cero
+        uint64_t semilla;          ///< Semilla del mercado
+        uint64_t numEmpresas;      ///< Empresas guardadas
+        uint64_t numBloques;       ///< Bloques de historial guardados
+        uint64_t inicioMetadatos;  ///< Posición de los metadatos en el archivo
+        uint64_t numNoticias;      ///< Noticias guardadas
+        uint64_t secuenciaDiario;  ///< Último evento del diario incluido (ver diario.h)
+        uint8_t relleno[56];       ///< Ceros hasta 128 bytes
+    };
+    static_assert(sizeof(Cabecera) == 128, "La cabecera debe ocupar 128 bytes");
+    static_assert(sizeof(BloqueHistorial) % 64 == 0, "Los bloques deben quedar alineados a 64 bytes");
+
+    /**
+     * @brief Guarda el estado completo en un archivo.
+     * @param ruta Archivo destino (se reemplaza).
+     * @param arbol Mercado.
+     * @param cola Cola de noticias.
+     * @param usuario Portafolio del usuario.
+     * @param presupuesto Presupuesto disponible del usuario.
+     * @param secuenciaDiario Último evento del diario que ya refleja este estado (0 sin diario).
+     * @return true si se escribió completo y llegó al disco.
+     */
+    static bool guardar(const string& ruta, const ABBEmpresas& arbol, const ColaPrioridadNoticias& cola,
+                        const Portafolio& usuario, float presupuesto, uint64_t secuenciaDiario = 0) {
+        EscritorBinario salida(ruta);
+        vector<Empresa*> empresas = arbol.obtenerEmpresasOrdenadas();
+
+        Cabecera cabecera;
+        memset(&cabecera, 0, sizeof(cabecera));
+        memcpy(cabecera.magia, "MERCSNAP", 8);
+        cabecera.version = VERSION;
+        cabecera.ordenBytes = 0x01020304;
+        cabecera.tamanoBloque = sizeof(BloqueHistorial);
+        cabecera.semilla = arbol.semilla();
+        cabecera.numEmpresas = empresas.size();
+        for (Empresa* e : empresas) cabecera.numBloques += e->historialPrecios.numBloques();
+        cabecera.inicioMetadatos = sizeof(Cabecera) + cabecera.numBloques * sizeof(BloqueHistorial);
+        cabecera.numNoticias = cola.tamano();
+        cabecera.secuenciaDiario = secuenciaDiario;
+        salida.valor(cabecera);
+
+        for (Empresa* e : empresas) e->historialPrecios.guardarBloques(salida);
+        for (Empresa* e : empresas) {
+            salida.texto(e->ticker);
+            salida.texto(e->nombre);
+            salida.texto(e->sector);
+            salida.valor(e->precioActual);
+        }
+        for (Empresa* e : empresas) e->historialPrecios.guardarEstado(salida);
+        cola.guardar(salida);
+        salida.valor(presupuesto);
+        usuario.guardar(salida);
+        return salida.cerrar();
+    }
+
+    /**
+     * @brief Carga una instantánea sobre un estado vacío.
+     *
+     * Si devuelve false después de empezar a restaurar (archivo dañado o
+     * truncado), el estado queda a medias y debe descartarse.
+     * @param ruta Archivo de la instantánea.
+     * @param arbol Mercado sin empresas (por ejemplo, ABBEmpresas(ConfiguracionMercado) con 0 empresas).
+     * @param cola Cola de noticias vacía.
+     * @param usuario Portafolio a reemplazar.
+     * @param presupuesto Presupuesto restaurado (salida).
+     * @param secuenciaDiario Si no es nulo, recibe el último evento del diario incluido.
+     * @return false (con un mensaje) si el archivo no existe, es de otra versión o está dañado.
+     */
+    static bool cargar(const string& ruta, ABBEmpresas& arbol, ColaPrioridadNoticias& cola, Portafolio& usuario,
+                       float& presupuesto, uint64_t* secuenciaDiario = nullptr) {
+        unique_ptr<ArchivoMapeado> archivo(new ArchivoMapeado(ruta, true));
+        if (!archivo->abierto()) {
+            cout << "No se pudo abrir la instantánea " << ruta << "\n";
+            return false;
+        }
+        Cabecera cabecera;
+        if (archivo->tamano() < sizeof(Cabecera)) {
+            cout << "La instantánea " << ruta << " está dañada.\n";
+            return false;
+        }
+        memcpy(&cabecera, archivo->inicio(), sizeof(Cabecera));
+        if (memcmp(cabecera.magia, "MERCSNAP", 8) != 0 || cabecera.ordenBytes != 0x01020304 ||
+            cabecera.tamanoBloque != sizeof(BloqueHistorial)) {
+            cout << "El archivo " << ruta << " no es una instantánea compatible.\n";
+            return false;
+        }
+        if (cabecera.version != VERSION) {
+            cout << "La instantánea " << ruta << " es de la versión " << cabecera.version << " (se esperaba "
+                 << VERSION << ").\n";
+            return false;
+        }
+        if (cabecera.numBloques > (archivo->tamano() - sizeof(Cabecera)) / sizeof(BloqueHistorial) ||
+            cabecera.inicioMetadatos != sizeof(Cabecera) + cabecera.numBloques * sizeof(BloqueHistorial)) {
+            cout << "La instantánea " << ruta << " está dañada.\n";
+            return false;
+        }
+        if (!arbol.vacio()) {
+            cout << "La instantánea solo se puede cargar sobre un mercado vacío.\n";
+            return false;
+        }
+
+        // Empresas: se validan antes de tocar el mercado y luego se cargan en bloque
+        LectorBinario entrada(archivo->inicio() + cabecera.inicioMetadatos,
+                              archivo->tamano() - cabecera.inicioMetadatos);
+        vector<DatosEmpresa> datos(cabecera.numEmpresas <= archivo->tamano() ? cabecera.numEmpresas : 0);
+        bool ordenados = true;
+        for (size_t i = 0; i < datos.size() && entrada.correcto(); ++i) {
+            datos[i].ticker = entrada.texto();
+            datos[i].nombre = entrada.texto();
+            datos[i].sector = entrada.texto();
+            datos[i].precio = entrada.valor<float>();
+            if (i > 0 && !(datos[i - 1].ticker < datos[i].ticker)) ordenados = false;
+        }
+        if (!entrada.correcto() || !ordenados || datos.size() != cabecera.numEmpresas) {
+            cout << "La instantánea " << ruta << " está dañada.\n";
+            return false;
+        }
+        arbol.fijarSemilla(cabecera.semilla);
+        arbol.cargarEmpresasOrdenadas(datos);
+
+        // Los historiales apuntan a los bloques del archivo, que el mercado mantiene vivo
+        BloqueHistorial* bloque = reinterpret_cast<BloqueHistorial*>(archivo->inicio() + sizeof(Cabecera));
+        BloqueHistorial* finBloques = bloque + cabecera.numBloques;
+        arbol.conservarArchivo(std::move(archivo));
+        for (Empresa* e : arbol.obtenerEmpresasOrdenadas()) {
+            if (!entrada.correcto()) break;
+            e->historialPrecios.cargarEstado(entrada, bloque, finBloques);
+        }
+        if (bloque != finBloques) entrada.invalidar();
+
+        cola.cargar(entrada, cabecera.numNoticias);
+        presupuesto = entrada.valor<float>();
+        usuario.cargar(entrada);
+        if (!entrada.correcto()) {
+            cout << "La instantánea " << ruta << " está dañada.\n";
+            return false;
+        }
+        if (secuenciaDiario) *secuenciaDiario = cabecera.secuenciaDiario;
+        return true;
+    }
+};
+
+#endif